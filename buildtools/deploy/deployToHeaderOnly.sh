@@ -55,7 +55,12 @@ for i in \
     cluon/MetaMessage.hpp \
     cluon/MessageParser.hpp \
     cluon/TerminateHandler.hpp \
+    cluon/Reactor.hpp \
     cluon/NotifyingPipeline.hpp \
+    cluon/NotifyingPipelinePool.hpp \
+    cluon/ReceiveBuffer.hpp \
+    cluon/SocketFilter.hpp \
+    cluon/LatencyHistogram.hpp \
     cluon/IPv4Tools.hpp \
     cluon/UDPPacketSizeConstraints.hpp \
     cluon/UDPSender.hpp \
@@ -63,6 +68,7 @@ for i in \
     cluon/TCPConnection.hpp \
     cluon/TCPServer.hpp \
     cluon/ProtoConstants.hpp \
+    cluon/ProtoSizeVisitor.hpp \
     cluon/ToProtoVisitor.hpp \
     cluon/FromProtoVisitor.hpp \
     cluon/FromLCMVisitor.hpp \
@@ -76,6 +82,8 @@ for i in \
     cluon/ToODVDVisitor.hpp \
     cluon/ToMsgPackVisitor.hpp \
     cluon/Envelope.hpp \
+    cluon/EnvelopeView.hpp \
+    cluon/Fragmentation.hpp \
     cluon/EnvelopeConverter.hpp \
     cluon/GenericMessage.hpp \
     cluon/LCMToGenericMessage.hpp \
@@ -95,11 +103,16 @@ for i in \
     MetaMessage.cpp \
     MessageParser.cpp \
     TerminateHandler.cpp \
+    Reactor.cpp \
+    ReceiveBuffer.cpp \
+    SocketFilter.cpp \
+    LatencyHistogram.cpp \
     IPv4Tools.cpp \
     UDPSender.cpp \
     UDPReceiver.cpp \
     TCPConnection.cpp \
     TCPServer.cpp \
+    ProtoSizeVisitor.cpp \
     ToProtoVisitor.cpp \
     FromProtoVisitor.cpp \
     FromLCMVisitor.cpp \
@@ -113,6 +126,8 @@ for i in \
     ToMsgPackVisitor.cpp \
     OD4Session.cpp \
     ToODVDVisitor.cpp \
+    EnvelopeView.cpp \
+    Fragmentation.cpp \
     EnvelopeConverter.cpp \
     Player.cpp \
     SharedMemory.cpp; do
@@ -10,9 +10,11 @@
 #define CLUON_ENVELOPE_HPP
 
 #include "cluon/FromProtoVisitor.hpp"
+#include "cluon/ProtoSizeVisitor.hpp"
 #include "cluon/ToProtoVisitor.hpp"
 #include "cluon/cluonDataStructures.hpp"
 
+#include <cstddef>
 #include <cstring>
 #include <istream>
 #include <sstream>
@@ -30,34 +32,29 @@ namespace cluon {
  * @return String representation of the Envelope to be sent to OpenDaVINCI v4.
  */
 inline std::string serializeEnvelope(cluon::data::Envelope &&envelope) noexcept {
-    std::string dataToSend;
+    // Reserve the OD4 header and encode the Envelope directly behind it.
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    std::string dataToSend(OD4_HEADER_SIZE, '\0');
     {
-        std::stringstream sstr;
+        cluon::ProtoSizeVisitor sizeVisitor;
+        envelope.accept(sizeVisitor);
+        dataToSend.reserve(OD4_HEADER_SIZE + sizeVisitor.encodedSize());
 
-        cluon::ToProtoVisitor protoEncoder;
+        cluon::ToProtoVisitor protoEncoder{dataToSend};
         envelope.accept(protoEncoder);
-
-        const std::string tmp{protoEncoder.encodedData()};
-        uint32_t length{static_cast<uint32_t>(tmp.size())};
-        length <<= 8;
-        length = htole32(length);
-
-        // Add OD4 header.
-        constexpr unsigned char OD4_HEADER_BYTE0 = 0x0D;
-        constexpr unsigned char OD4_HEADER_BYTE1 = 0xA4;
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE0));
-        auto posByte1 = sstr.tellp();
-        sstr.write(reinterpret_cast<char *>(&length), static_cast<std::streamsize>(sizeof(uint32_t)));
-        auto posByte5 = sstr.tellp();
-        sstr.seekp(posByte1);
-        sstr.put(static_cast<char>(OD4_HEADER_BYTE1));
-        sstr.seekp(posByte5);
-
-        // Write payload.
-        sstr.write(tmp.data(), static_cast<std::streamsize>(tmp.size()));
-
-        dataToSend = sstr.str();
     }
+
+    uint32_t length{static_cast<uint32_t>(dataToSend.size() - OD4_HEADER_SIZE)};
+    length <<= 8;
+    length = htole32(length);
+
+    // Add OD4 header.
+    constexpr unsigned char OD4_HEADER_BYTE0 = 0x0D;
+    constexpr unsigned char OD4_HEADER_BYTE1 = 0xA4;
+    std::memcpy(&dataToSend[1], &length, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+    dataToSend[0] = static_cast<char>(OD4_HEADER_BYTE0);
+    dataToSend[1] = static_cast<char>(OD4_HEADER_BYTE1);
+
     return dataToSend;
 }
 
@@ -109,9 +106,8 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
                 retVal = static_cast<int32_t>(LENGTH) == in.gcount();
 #endif
                 if (retVal) {
-                    std::stringstream sstr(std::string(buffer.begin(), buffer.begin() + static_cast<std::streamsize>(LENGTH)));
                     cluon::FromProtoVisitor protoDecoder;
-                    protoDecoder.decodeFrom(sstr, env);
+                    protoDecoder.decodeFrom(buffer.data(), LENGTH, env);
                 }
             }
         }
@@ -119,6 +115,34 @@ inline std::pair<bool, cluon::data::Envelope> extractEnvelope(std::istream &in)
     return std::make_pair(retVal, env);
 }
 
+/**
+ * This method extracts an Envelope from the given contiguous buffer that holds
+ * bytes in the format described for extractEnvelope(std::istream &) without
+ * copying the buffer into an intermediate stream.
+ *
+ * @param data Pointer to the first byte of the OD4 header.
+ * @param length Number of bytes available in data.
+ * @return cluon::data::Envelope.
+ */
+inline std::pair<bool, cluon::data::Envelope> extractEnvelope(const char *data, std::size_t length) noexcept {
+    bool retVal{false};
+    cluon::data::Envelope env;
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    if ((nullptr != data) && (OD4_HEADER_SIZE <= length)) {
+        if ((0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1]))) {
+            uint32_t length_{0};
+            std::memcpy(&length_, data + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+            const uint32_t LENGTH{le32toh(length_) >> 8};
+            if ((OD4_HEADER_SIZE + LENGTH) <= length) {
+                cluon::FromProtoVisitor protoDecoder;
+                protoDecoder.decodeFrom(data + OD4_HEADER_SIZE, LENGTH, env);
+                retVal = true;
+            }
+        }
+    }
+    return std::make_pair(retVal, env);
+}
+
 /**
  * @return Extract a given Envelope's payload into the desired type.
  */
@@ -126,11 +150,9 @@ template <typename T>
 inline T extractMessage(cluon::data::Envelope &&envelope) noexcept {
     cluon::FromProtoVisitor decoder;
 
-    std::stringstream sstr(envelope.serializedData());
-    decoder.decodeFrom(sstr);
-
+    const std::string payload{envelope.serializedData()};
     T msg;
-    msg.accept(decoder);
+    decoder.decodeFrom(payload.data(), payload.size(), msg);
 
     return msg;
 }
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_ENVELOPEVIEW_HPP
+#define CLUON_ENVELOPEVIEW_HPP
+
+#include "cluon/cluon.hpp"
+#include "cluon/cluonDataStructures.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+
+namespace cluon {
+/**
+This class provides a read-only view onto a Proto-encoded Envelope. Only the
+Envelope's meta data (dataType, senderStamp, and the time stamps) is decoded;
+the payload (serializedData) is not copied but referenced in the buffer that
+was passed to decodeFrom. Thus, the buffer must outlive this view.
+
+A complete cluon::data::Envelope is only created on demand:
+
+\code{.cpp}
+// data holds an OD4-framed Envelope, i.e., 0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded Envelope.
+std::string data = <...>
+auto retVal = cluon::extractEnvelopeView(data.data(), data.size());
+if (retVal.first && (MyMessage::ID() == retVal.second.dataType())) {
+    cluon::data::Envelope env = retVal.second.envelope();
+}
+\endcode
+*/
+class LIBCLUON_API EnvelopeView {
+   public:
+    EnvelopeView()                     = default;
+    EnvelopeView(const EnvelopeView &) = default;
+    EnvelopeView(EnvelopeView &&)      = default;
+    EnvelopeView &operator=(const EnvelopeView &) = default;
+    EnvelopeView &operator=(EnvelopeView &&) = default;
+    ~EnvelopeView()                          = default;
+
+   public:
+    /**
+     * This method decodes the meta data of a Proto-encoded Envelope (without
+     * OD4 header) from the given buffer.
+     *
+     * @param data Pointer to the first byte of the Proto-encoded Envelope.
+     * @param length Number of bytes of the Proto-encoded Envelope.
+     * @return true if the Envelope could be decoded.
+     */
+    bool decodeFrom(const char *data, std::size_t length) noexcept;
+
+    /**
+     * @return Complete cluon::data::Envelope including a copy of the payload.
+     */
+    cluon::data::Envelope envelope() const noexcept;
+
+    int32_t dataType() const noexcept;
+    uint32_t senderStamp() const noexcept;
+    cluon::data::TimeStamp sent() const noexcept;
+    cluon::data::TimeStamp received() const noexcept;
+    cluon::data::TimeStamp sampleTimeStamp() const noexcept;
+
+    /**
+     * @return Pointer to the first byte of the payload in the decoded buffer.
+     */
+    const char *serializedData() const noexcept;
+
+    /**
+     * @return Number of bytes of the payload.
+     */
+    std::size_t serializedDataLength() const noexcept;
+
+   private:
+    static std::size_t fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept;
+    static cluon::data::TimeStamp decodeTimeStamp(const char *data, std::size_t length) noexcept;
+
+   private:
+    int32_t m_dataType{0};
+    uint32_t m_senderStamp{0};
+    cluon::data::TimeStamp m_sent{};
+    cluon::data::TimeStamp m_received{};
+    cluon::data::TimeStamp m_sampleTimeStamp{};
+    const char *m_serializedData{nullptr};
+    std::size_t m_serializedDataLength{0};
+};
+
+/**
+ * This method extracts an EnvelopeView from the given buffer that holds an
+ * OD4-framed Envelope (0x0D 0xA4 LEN0 LEN1 LEN2 Proto-encoded Envelope).
+ *
+ * @param data Pointer to the first byte of the OD4 header.
+ * @param length Number of bytes available in data.
+ * @return Pair of bool and EnvelopeView referencing data; bool is false on invalid data.
+ */
+LIBCLUON_API std::pair<bool, EnvelopeView> extractEnvelopeView(const char *data, std::size_t length) noexcept;
+
+/**
+ * This method reads the next OD4-framed Envelope from the given istream into
+ * buffer and extracts an EnvelopeView referencing buffer. The memory of
+ * buffer is reused for consecutive calls.
+ *
+ * @param in Stream to read from.
+ * @param buffer Buffer to hold the complete OD4-framed Envelope.
+ * @return Pair of bool and EnvelopeView referencing buffer; bool is false on invalid data.
+ */
+LIBCLUON_API std::pair<bool, EnvelopeView> extractEnvelopeView(std::istream &in, std::string &buffer) noexcept;
+
+/**
+ * This method scans the next OD4-framed Envelope from the given istream
+ * without decoding its payload: Only the fields dataType, sampleTimeStamp, and
+ * senderStamp are kept in buffer while all other fields are skipped. Envelopes
+ * below 64KB are read at once; fields of at least 64KB in larger Envelopes are
+ * skipped using seekg if the stream is seekable. This method is meant for
+ * building indexes over large recordings where the payload is not needed.
+ *
+ * The returned EnvelopeView does not reference any payload and sent/received
+ * are left at their default values. After a successful call, the istream is
+ * positioned at the beginning of the next OD4-framed Envelope.
+ *
+ * @param in Stream to read from.
+ * @param buffer Buffer to hold the meta data of the scanned Envelope.
+ * @return Pair of bool and EnvelopeView; bool is false on invalid data.
+ */
+LIBCLUON_API std::pair<bool, EnvelopeView> scanEnvelopeView(std::istream &in, std::string &buffer) noexcept;
+
+/**
+ * This method scans the next OD4-framed Envelope like scanEnvelopeView above
+ * and additionally reports the number of bytes consumed from the stream so
+ * that callers can track the stream's position without calling tellg.
+ *
+ * @param in Stream to read from.
+ * @param buffer Buffer to hold the meta data of the scanned Envelope.
+ * @param consumedBytes Number of bytes consumed from the stream.
+ * @return Pair of bool and EnvelopeView; bool is false on invalid data.
+ */
+LIBCLUON_API std::pair<bool, EnvelopeView> scanEnvelopeView(std::istream &in, std::string &buffer, uint64_t &consumedBytes) noexcept;
+
+} // namespace cluon
+
+#endif
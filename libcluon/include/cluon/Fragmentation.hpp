@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_FRAGMENTATION_HPP
+#define CLUON_FRAGMENTATION_HPP
+
+#include "cluon/cluon.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cluon {
+
+/**
+Header layout of a fragment (all numbers in little endian):
+
+0x0D 0xA5 messageIdentifier(uint32) fragmentIndex(uint16) numberOfFragments(uint16) totalLength(uint32) offset(uint32) payload
+*/
+enum FragmentHeader : uint8_t {
+    FRAGMENT_HEADER_BYTE0 = 0x0D,
+    FRAGMENT_HEADER_BYTE1 = 0xA5,
+    FRAGMENT_HEADER_SIZE  = 18,
+};
+
+/**
+ * This method checks whether the given bytes start with a fragment header.
+ *
+ * @param data Pointer to the received bytes.
+ * @param length Number of received bytes.
+ * @return true if the bytes carry a fragment.
+ */
+LIBCLUON_API bool isFragment(const char *data, std::size_t length) noexcept;
+
+/**
+ * This method splits the given bytes into fragments that each fit into
+ * one datagram of the given maximum size.
+ *
+ * @param data Bytes to split.
+ * @param messageIdentifier Identifier shared by all fragments; it must differ between consecutive messages from one sender.
+ * @param maxDatagramSize Maximum size of one fragment including its header.
+ * @return List of fragments or an empty list if the data cannot be split.
+ */
+LIBCLUON_API std::vector<std::string> fragment(const std::string &data, uint32_t messageIdentifier, std::size_t maxDatagramSize) noexcept;
+
+/**
+Statistics describing the work of a FragmentReassembler.
+*/
+struct LIBCLUON_API FragmentReassemblerStatistics {
+    uint64_t receivedFragments{0};
+    uint64_t duplicateFragments{0};
+    uint64_t invalidFragments{0};
+    uint64_t completedMessages{0};
+    uint64_t expiredMessages{0};
+    uint64_t evictedMessages{0};
+    uint64_t lostFragments{0};
+    uint64_t pendingMessages{0};
+    uint64_t pendingBytes{0};
+};
+
+/**
+This class reassembles messages from fragments created by cluon::fragment.
+Fragments are grouped per sender and message identifier and can arrive in
+any order. Incomplete messages are dropped when their first fragment is older
+than the given timeout; when the memory for incomplete messages would exceed
+the given limit, the oldest incomplete messages are dropped. Fragments missing
+from dropped messages are counted as lost.
+
+\code{.cpp}
+cluon::FragmentReassembler reassembler{std::chrono::milliseconds(500), 64 * 1024 * 1024};
+auto retVal = reassembler.add(data.data(), data.size(), from, std::chrono::steady_clock::now());
+if (retVal.first) {
+    // retVal.second contains the complete message.
+}
+\endcode
+*/
+class LIBCLUON_API FragmentReassembler {
+   private:
+    FragmentReassembler(const FragmentReassembler &) = delete;
+    FragmentReassembler(FragmentReassembler &&)      = delete;
+    FragmentReassembler &operator=(const FragmentReassembler &) = delete;
+    FragmentReassembler &operator=(FragmentReassembler &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param timeout Maximum time to wait for the missing fragments of a message.
+     * @param maxPendingBytes Maximum number of bytes held for incomplete messages.
+     */
+    FragmentReassembler(std::chrono::milliseconds timeout, std::size_t maxPendingBytes) noexcept;
+
+    /**
+     * This method adds a fragment.
+     *
+     * @param data Pointer to the fragment including its header.
+     * @param length Number of bytes of the fragment.
+     * @param from Sender of the fragment, e.g., encoded with cluon::encodeSenderAddress.
+     * @param now Arrival time of the fragment.
+     * @return Pair: true and the complete message if this fragment completed it.
+     */
+    std::pair<bool, std::string> add(const char *data, std::size_t length, uint64_t from, std::chrono::steady_clock::time_point now) noexcept;
+
+    /**
+     * @return Statistics about the fragments and messages so far.
+     */
+    FragmentReassemblerStatistics statistics() noexcept;
+
+   private:
+    struct PendingMessage {
+        std::string m_data{};
+        std::vector<bool> m_receivedFragments{};
+        uint32_t m_missingFragments{0};
+        std::chrono::steady_clock::time_point m_firstArrival{};
+    };
+    using MessageKey = std::pair<uint64_t, uint32_t>;
+
+    void drop(const MessageKey &key, bool expired) noexcept;
+
+   private:
+    const std::chrono::milliseconds m_timeout;
+    const std::size_t m_maxPendingBytes;
+
+    std::mutex m_pendingMessagesMutex{};
+    std::map<MessageKey, PendingMessage> m_pendingMessages{};
+    std::deque<std::pair<MessageKey, std::chrono::steady_clock::time_point>> m_arrivalOrder{};
+    FragmentReassemblerStatistics m_statistics{};
+};
+} // namespace cluon
+
+#endif
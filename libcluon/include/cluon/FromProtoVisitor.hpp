@@ -11,14 +11,14 @@
 
 #include "cluon/ProtoConstants.hpp"
 #include "cluon/cluon.hpp"
-#include "cluon/any/any.hpp"
 
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <istream>
+#include <iterator>
 #include <sstream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace cluon {
@@ -45,6 +45,14 @@ class LIBCLUON_API FromProtoVisitor {
      */
     void decodeFrom(std::istream &in) noexcept;
 
+    /**
+     * This method decodes a given contiguous buffer into Proto.
+     *
+     * @param data Pointer to the first byte to decode.
+     * @param length Number of bytes to decode.
+     */
+    void decodeFrom(const char *data, std::size_t length) noexcept;
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -72,17 +80,16 @@ class LIBCLUON_API FromProtoVisitor {
         (void)name;
 
         if (m_callToDecodeFromWithDirectVisit) {
-            std::stringstream sstr{std::move(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value)))};
+            // Decode the nested message directly from the enclosing buffer.
             cluon::FromProtoVisitor nestedProtoDecoder;
-            nestedProtoDecoder.decodeFrom(sstr, v);
+            nestedProtoDecoder.decodeFrom(m_stringValue, static_cast<std::size_t>(m_value), v);
         }
-        else if (0 < m_mapOfKeyValues.count(id)) {
-            try {
-                std::stringstream sstr{linb::any_cast<std::string>(m_mapOfKeyValues[id])};
+        else {
+            const FieldEntry *entry{findField(id, ProtoConstants::LENGTH_DELIMITED)};
+            if (nullptr != entry) {
                 cluon::FromProtoVisitor nestedProtoDecoder;
-                nestedProtoDecoder.decodeFrom(sstr);
+                nestedProtoDecoder.decodeFrom(m_buffer.data() + static_cast<std::size_t>(entry->value), entry->length);
                 v.accept(nestedProtoDecoder);
-            } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
             }
         }
     }
@@ -96,48 +103,28 @@ class LIBCLUON_API FromProtoVisitor {
      */
     template<typename T>
     void decodeFrom(std::istream &in, T &v) noexcept {
+        if (in.good()) {
+            const std::string buffer{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+            decodeFrom(buffer.data(), buffer.size(), v);
+        }
+    }
+
+    /**
+     * This method decodes a given contiguous buffer into corresponding fields
+     * of v. Length-delimited fields are not copied but handed to v as views
+     * into the given buffer; thus, the buffer must remain valid during this call.
+     *
+     * @param data Pointer to the first byte to decode.
+     * @param length Number of bytes to decode.
+     * @param v Data structure to receive the decoded values.
+     */
+    template<typename T>
+    void decodeFrom(const char *data, std::size_t length, T &v) noexcept {
         m_callToDecodeFromWithDirectVisit = true;
-        while (in.good()) {
-            // First stage: Read keyFieldType (encoded as VarInt).
-            if (0 < fromVarInt(in, m_keyFieldType)) {
-                // Succeeded to read keyFieldType entry; extract information.
-                m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
-                m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
-                switch (m_protoType) {
-                    case ProtoConstants::VARINT:
-                    {
-                        // Directly decode VarInt value.
-                        fromVarInt(in, m_value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::EIGHT_BYTES:
-                    {
-                        readBytesFromStream(in, sizeof(double), m_doubleValue.buffer.data());
-                        m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::FOUR_BYTES:
-                    {
-                        readBytesFromStream(in, sizeof(float), m_floatValue.buffer.data());
-                        m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                    case ProtoConstants::LENGTH_DELIMITED:
-                    {
-                        fromVarInt(in, m_value);
-                        const std::size_t BYTES_TO_READ_FROM_STREAM{static_cast<std::size_t>(m_value)};
-                        if (m_stringValue.capacity() < BYTES_TO_READ_FROM_STREAM) {
-                            m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
-                        }
-                        readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
-                        v.accept(m_fieldId, *this);
-                    }
-                    break;
-                }
-            }
+        const char *position{data};
+        const char *end{data + length};
+        while (readNextField(position, end)) {
+            v.accept(m_fieldId, *this);
         }
         m_callToDecodeFromWithDirectVisit = false;
     }
@@ -148,15 +135,47 @@ class LIBCLUON_API FromProtoVisitor {
     int32_t fromZigZag32(uint32_t v) noexcept;
     int64_t fromZigZag64(uint64_t v) noexcept;
 
-    std::size_t fromVarInt(std::istream &in, uint64_t &value) noexcept;
+    std::size_t fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept;
+
+    /**
+     * This method reads the next key/value pair from the given buffer range
+     * and advances position accordingly.
+     *
+     * @param position Current read position; updated on return.
+     * @param end One past the last byte to read.
+     * @return true if a complete key/value pair was read.
+     */
+    bool readNextField(const char *&position, const char *end) noexcept;
+
+   private:
+    /**
+     * This struct describes one decoded field in m_buffer.
+     */
+    struct FieldEntry {
+        uint32_t fieldId{0};
+        ProtoConstants protoType{ProtoConstants::VARINT};
+        // VarInt value, raw bits of fixed-size values, or offset into m_buffer.
+        uint64_t value{0};
+        // Length of length-delimited values.
+        std::size_t length{0};
+    };
 
-    void readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept;
+    /**
+     * This method looks up the first decoded field with the given identifier.
+     *
+     * @param fieldId Field identifier to look up.
+     * @param protoType Expected Protobuf type.
+     * @return Pointer to the entry or nullptr if not found or of different type.
+     */
+    const FieldEntry *findField(uint32_t fieldId, ProtoConstants protoType) const noexcept;
 
    private:
     // This Boolean flag indicates whether we consecutively decode from istream
     // and inject the decoded values directly into the receiving data structure.
     bool m_callToDecodeFromWithDirectVisit{false};
-    std::unordered_map<uint32_t, linb::any, UseUInt32ValueAsHashKey> m_mapOfKeyValues{};
+    // Copy of the decoded bytes and table of its fields sorted by field identifier.
+    std::string m_buffer{};
+    std::vector<FieldEntry> m_fields{};
 
    private:
     // Fields necessary to decode from an istream.
@@ -176,8 +195,8 @@ class LIBCLUON_API FromProtoVisitor {
         float floatValue{0};
     } m_floatValue;
 
-    // Buffer for strings.
-    std::vector<char> m_stringValue;
+    // View into the decoded buffer for length-delimited values (length is m_value).
+    const char *m_stringValue{nullptr};
 
     uint64_t m_keyFieldType{0};
     ProtoConstants m_protoType{ProtoConstants::VARINT};
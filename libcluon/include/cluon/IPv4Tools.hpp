@@ -9,6 +9,7 @@
 #ifndef CLUON_IPV4TOOLS_HPP
 #define CLUON_IPV4TOOLS_HPP
 
+#include <cstdint>
 #include <string>
 
 namespace cluon {
@@ -18,6 +19,19 @@ namespace cluon {
  */
 std::string getIPv4FromHostname(const std::string &hostname) noexcept;
 
+/**
+ * @param address IPv4 address in network byte order (as in struct sockaddr_in).
+ * @param port Port in host byte order.
+ * @return Compact sender address: IPv4 address in host byte order in bits 16-47 and port in bits 0-15.
+ */
+uint64_t encodeSenderAddress(uint32_t address, uint16_t port) noexcept;
+
+/**
+ * @param sender Compact sender address.
+ * @return Human-readable representation of the sender (X.Y.Z.W:ABCD).
+ */
+std::string decodeSenderAddress(uint64_t sender) noexcept;
+
 } // namespace cluon
 
 #endif
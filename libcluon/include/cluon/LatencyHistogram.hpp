@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_LATENCYHISTOGRAM_HPP
+#define CLUON_LATENCYHISTOGRAM_HPP
+
+#include "cluon/cluon.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace cluon {
+/**
+ * Snapshot of a LatencyHistogram; percentiles are upper bounds of their buckets.
+ */
+struct LIBCLUON_API LatencyHistogramStatistics {
+    uint64_t samples{0};
+    uint64_t negativeSamples{0};
+    uint64_t minLatencyInNanoseconds{0};
+    uint64_t maxLatencyInNanoseconds{0};
+    uint64_t meanLatencyInNanoseconds{0};
+    uint64_t medianLatencyInNanoseconds{0};
+    uint64_t percentile90LatencyInNanoseconds{0};
+    uint64_t percentile99LatencyInNanoseconds{0};
+    uint64_t percentile999LatencyInNanoseconds{0};
+};
+
+/**
+This class counts latencies in logarithmic buckets with four linear sub-buckets
+per power of two; thus, a latency is known with a relative error below 25%
+across the full range from nanoseconds to centuries using a fixed amount of
+memory. Recording is lock-free and can be done from several threads while the
+histogram is queried. Negative latencies, e.g., caused by unsynchronized
+clocks on different hosts, are counted separately and recorded as zero.
+A disabled histogram ignores all latencies; owners like OD4Session and
+UDPReceiver create theirs disabled so that no clock is read and no counter
+is updated per datagram unless the latencies are of interest.
+
+\code{.cpp}
+cluon::LatencyHistogram histogram;
+histogram.record(std::chrono::microseconds(250));
+std::cout << histogram.statistics().percentile99LatencyInNanoseconds << std::endl;
+\endcode
+*/
+class LIBCLUON_API LatencyHistogram {
+   private:
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram(LatencyHistogram &&)      = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(LatencyHistogram &&) = delete;
+
+   public:
+    enum : std::size_t {
+        SUB_BUCKETS       = 4,
+        NUMBER_OF_BUCKETS = 63 * SUB_BUCKETS,
+    };
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param enabled true to record latencies.
+     */
+    explicit LatencyHistogram(bool enabled = true) noexcept;
+
+    /**
+     * This method enables or disables recording latencies.
+     *
+     * @param enabled true to record latencies.
+     */
+    void setEnabled(bool enabled) noexcept;
+
+    /**
+     * @return true if latencies are recorded.
+     */
+    bool isEnabled() const noexcept;
+
+    /**
+     * This method records one latency if this histogram is enabled.
+     *
+     * @param latency Latency to record.
+     */
+    void record(std::chrono::nanoseconds latency) noexcept;
+
+    /**
+     * This method removes all recorded latencies; latencies recorded
+     * concurrently might be lost.
+     */
+    void reset() noexcept;
+
+    /**
+     * @param percentile Percentile to compute [0 .. 100].
+     * @return Upper bound in nanoseconds of the bucket containing the given percentile.
+     */
+    uint64_t percentile(double percentile) const noexcept;
+
+    /**
+     * @return Snapshot of the recorded latencies.
+     */
+    LatencyHistogramStatistics statistics() const noexcept;
+
+    /**
+     * @return List of non-empty buckets as pairs of their upper bound in nanoseconds and number of samples.
+     */
+    std::vector<std::pair<uint64_t, uint64_t>> buckets() const noexcept;
+
+   private:
+    static std::size_t bucketOf(uint64_t latencyInNanoseconds) noexcept;
+    static uint64_t upperBoundOf(std::size_t bucket) noexcept;
+
+   private:
+    std::atomic<bool> m_enabled{true};
+    std::array<std::atomic<uint64_t>, NUMBER_OF_BUCKETS> m_buckets;
+    std::atomic<uint64_t> m_samples{0};
+    std::atomic<uint64_t> m_negativeSamples{0};
+    std::atomic<uint64_t> m_sumInNanoseconds{0};
+    std::atomic<uint64_t> m_minInNanoseconds;
+    std::atomic<uint64_t> m_maxInNanoseconds{0};
+};
+} // namespace cluon
+
+#endif
@@ -11,15 +11,70 @@
 
 #include "cluon/cluon.hpp"
 
+// clang-format off
+#ifndef WIN32
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+// clang-format on
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace cluon {
 
+/**
+ * Policy for a bounded NotifyingPipeline when a new entry is added to a full queue.
+ */
+enum class FullQueuePolicy : uint8_t {
+    BLOCK       = 0, // Wait until the consumer has made room.
+    DROP_OLDEST = 1, // Discard the oldest entry in the queue.
+    DROP_NEWEST = 2, // Discard the entry to be added.
+};
+
+/**
+ * Snapshot of the counters of a NotifyingPipeline.
+ */
+struct LIBCLUON_API NotifyingPipelineStatistics {
+    uint64_t queueDepth{0};
+    uint64_t maxQueueDepth{0};
+    uint64_t enqueuedEntries{0};
+    uint64_t droppedEntries{0};
+    uint64_t delegateCalls{0};
+    uint64_t totalDelegateLatencyInMicroseconds{0};
+    uint64_t maxDelegateLatencyInMicroseconds{0};
+};
+
+/**
+This class processes entries added from one thread in a separate thread by
+calling a delegate for each entry.
+
+By default, entries are stored in an unbounded std::deque guarded by a mutex.
+When a capacity is specified, entries are stored in a bounded lock-free ring
+buffer that supports exactly one producer thread calling add and hands over
+entries by move. The FullQueuePolicy determines what happens when the ring
+buffer is full. The mutex is then only used to let the pipeline thread sleep;
+notifyAll takes it only while the pipeline thread is waiting for entries.
+
+Instead of a delegate per entry, a batch delegate can be specified that is
+called with all entries pending at once. With setHighWaterMark, the number
+of pending entries can be limited below the capacity (or for the unbounded
+std::deque) by applying the FullQueuePolicy. The counters returned by
+statistics() can be used to size consumers; the delegate's latency is only
+measured after setDelegateLatencyEnabled(true).
+*/
 template <class T>
 class LIBCLUON_API NotifyingPipeline {
    private:
@@ -38,11 +93,58 @@ class LIBCLUON_API NotifyingPipeline {
         do { std::this_thread::sleep_for(1ms); } while (!m_pipelineThreadRunning.load());
     }
 
+    /**
+     * Constructor for a bounded single-producer/single-consumer pipeline.
+     *
+     * @param delegate Delegate to be called for each entry.
+     * @param capacity Maximum number of entries in the queue (rounded up to the next power of two).
+     * @param policy Policy when adding an entry to a full queue.
+     */
+    NotifyingPipeline(std::function<void(T &&)> delegate, std::size_t capacity, FullQueuePolicy policy)
+        : m_delegate(delegate)
+        , m_policy(policy) {
+        initializeRing(capacity);
+
+        m_pipelineThread = std::thread(&NotifyingPipeline::processPipeline, this);
+
+        // Let the operating system spawn the thread.
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (!m_pipelineThreadRunning.load());
+    }
+
+    /**
+     * Constructor for a pipeline calling the delegate with all pending entries at once.
+     *
+     * @param batchDelegate Delegate to be called with all pending entries.
+     * @param capacity Maximum number of entries in the single-producer/single-consumer
+     *                 queue (rounded up to the next power of two); 0 for an unbounded queue.
+     * @param policy Policy when adding an entry to a full queue.
+     */
+    NotifyingPipeline(std::function<void(std::vector<T> &&)> batchDelegate, std::size_t capacity, FullQueuePolicy policy)
+        : m_delegate(nullptr)
+        , m_batchDelegate(batchDelegate)
+        , m_policy(policy) {
+        if (0 < capacity) {
+            initializeRing(capacity);
+        }
+
+        m_pipelineThread = std::thread(&NotifyingPipeline::processPipeline, this);
+
+        // Let the operating system spawn the thread.
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (!m_pipelineThreadRunning.load());
+    }
+
     ~NotifyingPipeline() {
-        m_pipelineThreadRunning.store(false);
+        // Stop under the lock so that no thread can check its predicate and miss the notification.
+        try {
+            std::lock_guard<std::mutex> lck(m_pipelineMutex);
+            m_pipelineThreadRunning.store(false);
+        } catch (...) { m_pipelineThreadRunning.store(false); } // LCOV_EXCL_LINE
 
         // Wake any waiting threads.
         m_pipelineCondition.notify_all();
+        m_spaceCondition.notify_all();
 
         // Joining the thread could fail.
         try {
@@ -54,28 +156,366 @@ class LIBCLUON_API NotifyingPipeline {
 
    public:
     inline void add(T &&entry) noexcept {
-        std::unique_lock<std::mutex> lck(m_pipelineMutex);
-        m_pipeline.emplace_back(entry);
+        if (!m_ring) {
+            addToDeque(std::move(entry));
+            return;
+        }
+
+        bool added{tryPush(std::move(entry))};
+        if (!added) {
+            if (FullQueuePolicy::DROP_NEWEST == m_policy) {
+                m_droppedEntries++;
+            } else if (FullQueuePolicy::DROP_OLDEST == m_policy) {
+                T oldest;
+                while (!(added = tryPush(std::move(entry)))) {
+                    if (tryPop(oldest)) {
+                        m_droppedEntries++;
+                    }
+                }
+            } else {
+                // Wake the consumer and sleep until it made room.
+                while (!(added = tryPush(std::move(entry))) && m_pipelineThreadRunning.load()) {
+                    try {
+                        std::unique_lock<std::mutex> lck(m_pipelineMutex);
+                        m_producerWaiting.store(true);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        m_pipelineCondition.notify_all();
+                        m_spaceCondition.wait(lck, [this] { return (!this->m_pipelineThreadRunning.load() || this->hasSpace()); });
+                        m_producerWaiting.store(false);
+                    } catch (...) {} // LCOV_EXCL_LINE
+                }
+            }
+        }
+        if (added) {
+            m_enqueuedEntries++;
+            updateMaxQueueDepth(ringDepth());
+        }
+    }
+
+    /**
+     * This method adds an entry unless the queue is full; it never blocks or
+     * drops entries regardless of the FullQueuePolicy.
+     *
+     * @param entry Entry to add; it is left untouched if the queue is full.
+     * @return true if the entry was added.
+     */
+    inline bool tryAdd(T &&entry) noexcept {
+        bool added{false};
+        if (m_ring) {
+            if ((added = tryPush(std::move(entry)))) {
+                m_enqueuedEntries++;
+                updateMaxQueueDepth(ringDepth());
+            }
+        } else {
+            try {
+                std::lock_guard<std::mutex> lck(m_pipelineMutex);
+                if (m_pipeline.size() < m_highWaterMark.load()) {
+                    m_pipeline.emplace_back(std::move(entry));
+                    m_enqueuedEntries++;
+                    updateMaxQueueDepth(m_pipeline.size());
+                    added = true;
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+        return added;
+    }
+
+    /**
+     * @return Number of pending entries.
+     */
+    inline std::size_t size() noexcept {
+        std::size_t retVal{0};
+        if (m_ring) {
+            retVal = ringDepth();
+        } else {
+            try {
+                std::lock_guard<std::mutex> lck(m_pipelineMutex);
+                retVal = m_pipeline.size();
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+        return retVal;
+    }
+
+    /**
+     * This method limits the number of pending entries; when reached, the
+     * FullQueuePolicy is applied. For the bounded queue, the effective limit
+     * is the minimum of capacity and high-water mark.
+     *
+     * @param highWaterMark Maximum number of pending entries (at least 1).
+     */
+    inline void setHighWaterMark(std::size_t highWaterMark) noexcept {
+        m_highWaterMark.store((std::max<std::size_t>)(1, highWaterMark));
+        m_spaceCondition.notify_all();
     }
 
-    inline void notifyAll() noexcept { m_pipelineCondition.notify_all(); }
+    inline void notifyAll() noexcept {
+        if (m_ring) {
+            // Pairs with the fence in processPipeline: either the pipeline thread sees the new entries or we see it waiting.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_consumerWaiting.load(std::memory_order_relaxed)) {
+                return;
+            }
+            // Synchronize with the pipeline thread checking for entries before waiting.
+            try {
+                std::lock_guard<std::mutex> lck(m_pipelineMutex);
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+        m_pipelineCondition.notify_all();
+    }
 
     inline bool isRunning() noexcept { return m_pipelineThreadRunning.load(); }
 
+    /**
+     * This method changes the scheduling of the pipeline thread.
+     *
+     * @param realtimePriority SCHED_FIFO priority [1 .. 99]; 0 keeps the current scheduling.
+     * @param cpu CPU to pin the pipeline thread to (Linux only); -1 for no affinity.
+     * @return true if the scheduling could be changed; this usually requires CAP_SYS_NICE for a realtime priority.
+     */
+    inline bool setScheduling(int32_t realtimePriority, int32_t cpu) noexcept {
+        bool retVal{true};
+#ifdef WIN32
+        retVal = (0 == realtimePriority) && (0 > cpu);
+#else
+        if (0 < realtimePriority) {
+            struct sched_param parameter {};
+            parameter.sched_priority = realtimePriority;
+            retVal                   = (0 == ::pthread_setschedparam(m_pipelineThread.native_handle(), SCHED_FIFO, &parameter));
+        }
+        if (retVal && !(0 > cpu)) {
+#ifdef __linux__
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            if (CPU_SETSIZE > cpu) {
+                CPU_SET(static_cast<std::size_t>(cpu), &cpus);
+                retVal = (0 == ::pthread_setaffinity_np(m_pipelineThread.native_handle(), sizeof(cpus), &cpus));
+            } else {
+                retVal = false;
+            }
+#else
+            retVal = false;
+#endif
+        }
+#endif
+        return retVal;
+    }
+
+    /**
+     * @return Number of entries discarded due to the FullQueuePolicy.
+     */
+    inline uint64_t droppedEntries() const noexcept { return m_droppedEntries.load(); }
+
+    /**
+     * This method enables or disables measuring how long the delegate takes;
+     * it is disabled by default to avoid reading the clock twice per call.
+     *
+     * @param enabled true to measure the delegate's latency.
+     */
+    inline void setDelegateLatencyEnabled(bool enabled) noexcept { m_delegateLatencyEnabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @return true if the delegate's latency is measured.
+     */
+    inline bool isDelegateLatencyEnabled() const noexcept { return m_delegateLatencyEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @return Snapshot of the counters of this pipeline; the delegate latencies are 0 unless enabled.
+     */
+    inline NotifyingPipelineStatistics statistics() noexcept {
+        NotifyingPipelineStatistics stats;
+        stats.queueDepth                         = static_cast<uint64_t>(size());
+        stats.maxQueueDepth                      = m_maxQueueDepth.load();
+        stats.enqueuedEntries                    = m_enqueuedEntries.load();
+        stats.droppedEntries                     = m_droppedEntries.load();
+        stats.delegateCalls                      = m_delegateCalls.load(std::memory_order_acquire);
+        stats.totalDelegateLatencyInMicroseconds = m_totalDelegateLatencyInMicroseconds.load(std::memory_order_relaxed);
+        stats.maxDelegateLatencyInMicroseconds   = m_maxDelegateLatencyInMicroseconds.load(std::memory_order_relaxed);
+        return stats;
+    }
+
    private:
+    inline void initializeRing(std::size_t capacity) noexcept {
+        std::size_t size{2};
+        while (size < capacity) { size <<= 1; }
+        m_ring.reset(new Slot[size]);
+        m_ringMask = size - 1;
+        for (std::size_t i{0}; i < size; i++) { m_ring[i].m_sequence.store(i, std::memory_order_relaxed); }
+    }
+
+    inline void addToDeque(T &&entry) noexcept {
+        try {
+            std::unique_lock<std::mutex> lck(m_pipelineMutex);
+            if (m_pipeline.size() >= m_highWaterMark.load()) {
+                if (FullQueuePolicy::DROP_NEWEST == m_policy) {
+                    m_droppedEntries++;
+                    return;
+                } else if (FullQueuePolicy::DROP_OLDEST == m_policy) {
+                    while (m_pipeline.size() >= m_highWaterMark.load()) {
+                        m_pipeline.pop_front();
+                        m_droppedEntries++;
+                    }
+                } else {
+                    // Wake the consumer and wait until it made room.
+                    m_pipelineCondition.notify_all();
+                    m_spaceCondition.wait(
+                        lck, [this] { return (!this->m_pipelineThreadRunning.load() || (this->m_pipeline.size() < this->m_highWaterMark.load())); });
+                }
+            }
+            m_pipeline.emplace_back(std::move(entry));
+            m_enqueuedEntries++;
+            updateMaxQueueDepth(m_pipeline.size());
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+
+    inline void updateMaxQueueDepth(std::size_t depth) noexcept {
+        uint64_t maxQueueDepth{m_maxQueueDepth.load()};
+        while ((maxQueueDepth < depth) && !m_maxQueueDepth.compare_exchange_weak(maxQueueDepth, static_cast<uint64_t>(depth))) {}
+    }
+
+    template <typename DELEGATE, typename ENTRY>
+    inline void invokeDelegate(DELEGATE &delegate, ENTRY &&entry) noexcept {
+        if (nullptr != delegate) {
+            if (!m_delegateLatencyEnabled.load(std::memory_order_relaxed)) {
+                delegate(std::move(entry));
+                countDelegateCall();
+                return;
+            }
+
+            const auto BEFORE{std::chrono::steady_clock::now()};
+            delegate(std::move(entry));
+            const uint64_t LATENCY{static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - BEFORE).count())};
+
+            m_totalDelegateLatencyInMicroseconds.store(m_totalDelegateLatencyInMicroseconds.load(std::memory_order_relaxed) + LATENCY,
+                                                       std::memory_order_relaxed);
+            if (m_maxDelegateLatencyInMicroseconds.load(std::memory_order_relaxed) < LATENCY) {
+                m_maxDelegateLatencyInMicroseconds.store(LATENCY, std::memory_order_relaxed);
+            }
+            countDelegateCall();
+        }
+    }
+
+    inline void countDelegateCall() noexcept {
+        // Only the pipeline thread writes the delegate counters; thus, no read-modify-write is needed. Releasing
+        // the number of calls publishes the latencies stored before to statistics().
+        m_delegateCalls.store(m_delegateCalls.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    inline std::size_t ringDepth() const noexcept {
+        // Load the head first: the head never passes the tail, so the tail read afterwards is not behind it;
+        // both may advance in between, so the difference is clamped to the ring's capacity.
+        const std::size_t HEAD{m_ringHead.load(std::memory_order_acquire)};
+        const std::size_t TAIL{m_ringTail.load(std::memory_order_acquire)};
+        const std::size_t DEPTH{(TAIL > HEAD) ? (TAIL - HEAD) : 0};
+        return (DEPTH > m_ringMask + 1) ? (m_ringMask + 1) : DEPTH;
+    }
+
+    // Called only from the producer thread.
+    inline bool hasSpace() const noexcept {
+        const std::size_t POSITION{m_ringTail.load(std::memory_order_relaxed)};
+        return ((POSITION == m_ring[POSITION & m_ringMask].m_sequence.load(std::memory_order_acquire))
+                && ((POSITION - m_ringHead.load(std::memory_order_acquire)) < m_highWaterMark.load(std::memory_order_relaxed)));
+    }
+
+    // Called from the pipeline thread after taking entries from the ring.
+    inline void notifyWaitingProducer() noexcept {
+        // Pairs with the fence in add: either the producer sees the freed slot or we see it waiting.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_producerWaiting.load(std::memory_order_relaxed)) {
+            try {
+                std::lock_guard<std::mutex> lck(m_pipelineMutex);
+            } catch (...) {} // LCOV_EXCL_LINE
+            m_spaceCondition.notify_all();
+        }
+    }
+
+    inline bool hasEntries() const noexcept {
+        return (m_ring ? (m_ringHead.load(std::memory_order_acquire) != m_ringTail.load(std::memory_order_acquire)) : !m_pipeline.empty());
+    }
+
+    // Called only from the producer thread.
+    inline bool tryPush(T &&entry) noexcept {
+        const std::size_t POSITION{m_ringTail.load(std::memory_order_relaxed)};
+        Slot &slot = m_ring[POSITION & m_ringMask];
+        if ((POSITION != slot.m_sequence.load(std::memory_order_acquire))
+            || ((POSITION - m_ringHead.load(std::memory_order_acquire)) >= m_highWaterMark.load(std::memory_order_relaxed))) {
+            return false;
+        }
+        slot.m_entry = std::move(entry);
+        slot.m_sequence.store(POSITION + 1, std::memory_order_release);
+        m_ringTail.store(POSITION + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Called from the pipeline thread, and from the producer thread to drop the oldest entry.
+    inline bool tryPop(T &entry) noexcept {
+        std::size_t position{m_ringHead.load(std::memory_order_relaxed)};
+        while (true) {
+            Slot &slot = m_ring[position & m_ringMask];
+            const std::size_t SEQUENCE{slot.m_sequence.load(std::memory_order_acquire)};
+            if (SEQUENCE == position + 1) {
+                // Claim the slot before moving the entry out.
+                if (m_ringHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    entry = std::move(slot.m_entry);
+                    slot.m_sequence.store(position + m_ringMask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (SEQUENCE == position) {
+                // Queue is empty.
+                return false;
+            } else {
+                position = m_ringHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
     inline void processPipeline() noexcept {
         // Indicate to caller that we are ready.
         m_pipelineThreadRunning.store(true);
 
         while (m_pipelineThreadRunning.load()) {
             std::unique_lock<std::mutex> lck(m_pipelineMutex);
-            // Wait until the thread should stop or data is available.
-            m_pipelineCondition.wait(lck, [this] { return (!this->m_pipelineThreadRunning.load() || !this->m_pipeline.empty()); });
+            // Wait until the thread should stop or data is available; producers of the ring only notify a waiting thread.
+            m_consumerWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_pipelineCondition.wait(lck, [this] { return (!this->m_pipelineThreadRunning.load() || this->hasEntries()); });
+            m_consumerWaiting.store(false, std::memory_order_relaxed);
 
             // The condition will automatically lock the mutex after waking up.
             // As we are locking per entry, we need to unlock the mutex first.
             lck.unlock();
 
+            if (nullptr != m_batchDelegate) {
+                // Drain all pending entries at once.
+                std::vector<T> entries;
+                if (m_ring) {
+                    T entry;
+                    while (tryPop(entry)) {
+                        entries.emplace_back(std::move(entry));
+                    }
+                    notifyWaitingProducer();
+                } else {
+                    lck.lock();
+                    entries.reserve(m_pipeline.size());
+                    entries.assign(std::make_move_iterator(m_pipeline.begin()), std::make_move_iterator(m_pipeline.end()));
+                    m_pipeline.clear();
+                    lck.unlock();
+                    m_spaceCondition.notify_all();
+                }
+                if (!entries.empty()) {
+                    invokeDelegate(m_batchDelegate, std::move(entries));
+                }
+                continue;
+            }
+
+            if (m_ring) {
+                T entry;
+                while (tryPop(entry)) {
+                    notifyWaitingProducer();
+                    invokeDelegate(m_delegate, std::move(entry));
+                }
+                continue;
+            }
+
             uint32_t entries{0};
             {
                 lck.lock();
@@ -86,32 +526,57 @@ class LIBCLUON_API NotifyingPipeline {
                 T entry;
                 {
                     lck.lock();
-                    entry = m_pipeline.front();
-                    lck.unlock();
-                }
-
-                if (nullptr != m_delegate) {
-                    m_delegate(std::move(entry));
-                }
-
-                {
-                    lck.lock();
+                    if (m_pipeline.empty()) {
+                        // Entries could have been dropped in the meantime.
+                        lck.unlock();
+                        break;
+                    }
+                    entry = std::move(m_pipeline.front());
                     m_pipeline.pop_front();
                     lck.unlock();
                 }
+                m_spaceCondition.notify_all();
+
+                invokeDelegate(m_delegate, std::move(entry));
             }
         }
     }
 
    private:
+    struct Slot {
+        std::atomic<std::size_t> m_sequence{0};
+        T m_entry{};
+    };
+
     std::function<void(T &&)> m_delegate;
+    std::function<void(std::vector<T> &&)> m_batchDelegate{nullptr};
 
     std::atomic<bool> m_pipelineThreadRunning{false};
     std::thread m_pipelineThread{};
     std::mutex m_pipelineMutex{};
     std::condition_variable m_pipelineCondition{};
+    std::condition_variable m_spaceCondition{};
 
     std::deque<T> m_pipeline{};
+
+    // Bounded single-producer/single-consumer ring buffer.
+    FullQueuePolicy m_policy{FullQueuePolicy::BLOCK};
+    std::unique_ptr<Slot[]> m_ring{nullptr};
+    std::atomic<bool> m_producerWaiting{false};
+    std::atomic<bool> m_consumerWaiting{false};
+    std::size_t m_ringMask{0};
+    std::atomic<std::size_t> m_ringHead{0};
+    std::atomic<std::size_t> m_ringTail{0};
+    std::atomic<std::size_t> m_highWaterMark{(std::numeric_limits<std::size_t>::max)()};
+
+    // Counters.
+    std::atomic<uint64_t> m_maxQueueDepth{0};
+    std::atomic<uint64_t> m_enqueuedEntries{0};
+    std::atomic<uint64_t> m_droppedEntries{0};
+    std::atomic<bool> m_delegateLatencyEnabled{false};
+    std::atomic<uint64_t> m_delegateCalls{0};
+    std::atomic<uint64_t> m_totalDelegateLatencyInMicroseconds{0};
+    std::atomic<uint64_t> m_maxDelegateLatencyInMicroseconds{0};
 };
 } // namespace cluon
 
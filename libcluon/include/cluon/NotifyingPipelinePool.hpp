@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_NOTIFYINGPIPELINEPOOL_HPP
+#define CLUON_NOTIFYINGPIPELINEPOOL_HPP
+
+#include "cluon/NotifyingPipeline.hpp"
+#include "cluon/cluon.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace cluon {
+/**
+This class distributes entries to a fixed number of NotifyingPipelines, each
+processing its entries in a separate worker thread. The worker for an entry is
+selected from the ordering key returned by the key delegate; thus, entries with
+the same key (for instance, dataType and senderStamp of an Envelope) are
+processed in the order they were added while entries with different keys are
+spread across the workers. Without a key delegate, entries are distributed
+round-robin and no order is preserved.
+
+The delegate is called concurrently from all workers and hence, it needs to be
+thread-safe.
+*/
+template <class T>
+class LIBCLUON_API NotifyingPipelinePool {
+   private:
+    NotifyingPipelinePool(const NotifyingPipelinePool &) = delete;
+    NotifyingPipelinePool(NotifyingPipelinePool &&)      = delete;
+    NotifyingPipelinePool &operator=(const NotifyingPipelinePool &) = delete;
+    NotifyingPipelinePool &operator=(NotifyingPipelinePool &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param numberOfWorkers Number of worker threads (at least 1).
+     * @param orderingKey Delegate returning the ordering key for an entry; nullptr for round-robin.
+     * @param delegate Delegate to be called for each entry.
+     * @param capacity Capacity per worker for the bounded single-producer queue; 0 for an
+     *                 unbounded queue that allows adding entries from several threads.
+     * @param policy Policy when adding an entry to a full queue.
+     */
+    NotifyingPipelinePool(std::size_t numberOfWorkers,
+                          std::function<std::size_t(const T &)> orderingKey,
+                          std::function<void(T &&)> delegate,
+                          std::size_t capacity   = 0,
+                          FullQueuePolicy policy = FullQueuePolicy::BLOCK)
+        : m_orderingKey(orderingKey) {
+        numberOfWorkers = (0 < numberOfWorkers) ? numberOfWorkers : 1;
+        m_workers.reserve(numberOfWorkers);
+        for (std::size_t i{0}; i < numberOfWorkers; i++) {
+            if (0 < capacity) {
+                m_workers.emplace_back(std::make_unique<NotifyingPipeline<T>>(delegate, capacity, policy));
+            } else {
+                m_workers.emplace_back(std::make_unique<NotifyingPipeline<T>>(delegate));
+            }
+        }
+    }
+
+   public:
+    inline void add(T &&entry) noexcept {
+        const std::size_t WORKER{(nullptr != m_orderingKey) ? (mix(m_orderingKey(entry)) % m_workers.size()) : (m_nextWorker++ % m_workers.size())};
+        m_workers[WORKER]->add(std::move(entry));
+    }
+
+    /**
+     * This method adds an entry unless the queue of its worker is full.
+     *
+     * @param entry Entry to add; it is left untouched if the queue is full.
+     * @return true if the entry was added.
+     */
+    inline bool tryAdd(T &&entry) noexcept {
+        const std::size_t WORKER{(nullptr != m_orderingKey) ? (mix(m_orderingKey(entry)) % m_workers.size()) : (m_nextWorker++ % m_workers.size())};
+        return m_workers[WORKER]->tryAdd(std::move(entry));
+    }
+
+    /**
+     * @return Maximum number of pending entries over all workers.
+     */
+    inline std::size_t size() noexcept {
+        std::size_t retVal{0};
+        for (auto &worker : m_workers) { retVal = (std::max)(retVal, worker->size()); }
+        return retVal;
+    }
+
+    inline void notifyAll() noexcept {
+        for (auto &worker : m_workers) { worker->notifyAll(); }
+    }
+
+    inline bool isRunning() noexcept {
+        bool retVal{true};
+        for (auto &worker : m_workers) { retVal &= worker->isRunning(); }
+        return retVal;
+    }
+
+    /**
+     * @return Number of worker threads.
+     */
+    inline std::size_t numberOfWorkers() const noexcept { return m_workers.size(); }
+
+    /**
+     * This method enables or disables measuring the delegate's latency in all workers.
+     *
+     * @param enabled true to measure the delegate's latency.
+     */
+    inline void setDelegateLatencyEnabled(bool enabled) noexcept {
+        for (auto &worker : m_workers) { worker->setDelegateLatencyEnabled(enabled); }
+    }
+
+    /**
+     * @return Sum of the counters of all workers; maximum values are taken over all workers.
+     */
+    inline NotifyingPipelineStatistics statistics() noexcept {
+        NotifyingPipelineStatistics retVal;
+        for (auto &worker : m_workers) {
+            const NotifyingPipelineStatistics STATS{worker->statistics()};
+            retVal.queueDepth += STATS.queueDepth;
+            retVal.maxQueueDepth = (retVal.maxQueueDepth < STATS.maxQueueDepth) ? STATS.maxQueueDepth : retVal.maxQueueDepth;
+            retVal.enqueuedEntries += STATS.enqueuedEntries;
+            retVal.droppedEntries += STATS.droppedEntries;
+            retVal.delegateCalls += STATS.delegateCalls;
+            retVal.totalDelegateLatencyInMicroseconds += STATS.totalDelegateLatencyInMicroseconds;
+            retVal.maxDelegateLatencyInMicroseconds = (retVal.maxDelegateLatencyInMicroseconds < STATS.maxDelegateLatencyInMicroseconds)
+                                                          ? STATS.maxDelegateLatencyInMicroseconds
+                                                          : retVal.maxDelegateLatencyInMicroseconds;
+        }
+        return retVal;
+    }
+
+   private:
+    // Spread keys with few differing bits (like consecutive senderStamps) across workers.
+    static inline std::size_t mix(std::size_t key) noexcept {
+        uint64_t k{static_cast<uint64_t>(key)};
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        return static_cast<std::size_t>(k);
+    }
+
+   private:
+    std::function<std::size_t(const T &)> m_orderingKey;
+    std::atomic<std::size_t> m_nextWorker{0};
+    std::vector<std::unique_ptr<NotifyingPipeline<T>>> m_workers{};
+};
+} // namespace cluon
+
+#endif
@@ -9,14 +9,22 @@
 #ifndef CLUON_OD4SESSION_HPP
 #define CLUON_OD4SESSION_HPP
 
+#include "cluon/EnvelopeView.hpp"
+#include "cluon/Fragmentation.hpp"
+#include "cluon/LatencyHistogram.hpp"
+#include "cluon/NotifyingPipeline.hpp"
+#include "cluon/NotifyingPipelinePool.hpp"
 #include "cluon/Time.hpp"
 #include "cluon/ToProtoVisitor.hpp"
 #include "cluon/UDPReceiver.hpp"
+#include "cluon/UDPPacketSizeConstraints.hpp"
 #include "cluon/UDPSender.hpp"
 #include "cluon/cluon.hpp"
 #include "cluon/cluonDataStructures.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -24,6 +32,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -59,6 +68,20 @@ MyMessage msg;
 od4.send(msg);
 \endcode
 
+In Variant B, kernelDataTypeFilter(true) lets the kernel drop all Envelopes
+without a matching dataTrigger before they are copied to the OD4Session.
+
+Also in Variant B, the delegates of time-critical Envelopes can be moved to a
+dispatch lane with a thread of its own so that slow delegates, e.g., logging
+Envelopes, do not delay them; once a lane exists, all other delegates are
+called from a shared bulk lane:
+
+\code{.cpp}
+const int32_t REALTIME_PRIORITY{50}; // SCHED_FIFO; 0 keeps the default scheduling.
+const int32_t CPU{2};                // -1 for no affinity.
+od4.dispatchLane({MyControlMessage::ID()}, REALTIME_PRIORITY, CPU);
+\endcode
+
 Next to receive Envelopes, OD4Session can call a user-supplied lambda in a time-triggered
 way. The lambda is executed as long as it does not return false or throws an exception
 that is then caught in the method timeTrigger and the method is exited:
@@ -72,6 +95,45 @@ od4.timeTrigger(FREQ, [](){
   return false;
 }); // This call blocks until the lambda returns false.
 \endcode
+
+Envelopes can also be collected and sent with as few system calls as possible;
+between beginBatch() and flush(), all sent Envelopes are queued:
+
+\code{.cpp}
+od4.beginBatch();
+od4.send(msgA);
+od4.send(msgB);
+od4.flush(); // Both Envelopes are sent here.
+\endcode
+
+Using batchTimeTrigger(true), every call of a time-triggered delegate is
+wrapped in beginBatch() and flush() automatically.
+
+Envelopes that do not fit into one UDP datagram, e.g., carrying camera frames,
+can be sent after enabling fragmentLargeEnvelopes(true); they are split into
+fragments that are reassembled transparently by all receiving OD4Sessions:
+
+\code{.cpp}
+od4.fragmentLargeEnvelopes(true);
+od4.send(myLargeImage);
+
+cluon::FragmentReassemblerStatistics stats = od4.fragmentStatistics();
+std::cout << "Lost fragments: " << stats.lostFragments << std::endl;
+\endcode
+
+The latencies of received Envelopes can be recorded in histograms that are
+disabled by default and can be queried at any time: deliveryLatency() measures the time from receiving an
+Envelope's last datagram until its delegate is called and transportLatency()
+the time from sending an Envelope (cf. Envelope.sent) until receiving it;
+the latter requires synchronized clocks between different hosts:
+
+\code{.cpp}
+od4.timeStampMode(cluon::ReceiveTimeStampMode::HARDWARE);
+od4.transportLatency().setEnabled(true);
+// ...
+cluon::LatencyHistogramStatistics latency = od4.transportLatency().statistics();
+std::cout << "99th percentile: " << latency.percentile99LatencyInNanoseconds << "ns" << std::endl;
+\endcode
 */
 class LIBCLUON_API OD4Session {
    private:
@@ -89,8 +151,20 @@ class LIBCLUON_API OD4Session {
      *        if a nullptr is passed, the method dataTrigger can be used to set
      *        message specific delegates. Please note that it is NOT possible
      *        to have both: a delegate for "catch-all" and the data-triggered ones.
+     * @param numberOfWorkers Number of threads calling the delegates; Envelopes with the
+     *        same dataType and senderStamp are delivered in order while others are
+     *        delivered in parallel. For more than one worker, the delegates need to be thread-safe;
+     *        the receiving thread decodes each Envelope's meta data once and hands it to the workers.
+     * @param numberOfReceivers Number of sockets receiving this session's Envelopes; on Linux, each
+     *        socket receives only its shard of the dataTypes (using a BPF socket filter) and feeds
+     *        its own numberOfWorkers threads. Envelopes with the same dataType are always received
+     *        by the same socket. For more than one receiver, the delegates need to be thread-safe.
      */
-    OD4Session(uint16_t CID, std::function<void(cluon::data::Envelope &&envelope)> delegate = nullptr) noexcept;
+    OD4Session(uint16_t CID,
+               std::function<void(cluon::data::Envelope &&envelope)> delegate = nullptr,
+               std::size_t numberOfWorkers                                 = 1,
+               std::size_t numberOfReceivers                               = 1) noexcept;
+    ~OD4Session() noexcept;
 
     /**
      * This method will send a given Envelope to this OpenDaVINCI v4 session.
@@ -99,6 +173,114 @@ class LIBCLUON_API OD4Session {
      */
     void send(cluon::data::Envelope &&envelope) noexcept;
 
+    /**
+     * This method will send the given Envelopes to this OpenDaVINCI v4 session
+     * in the given order with as few system calls as possible.
+     *
+     * @param envelopes to be sent.
+     */
+    void send(std::vector<cluon::data::Envelope> &&envelopes) noexcept;
+
+    /**
+     * This method starts a batch: All Envelopes sent afterwards from any
+     * thread are queued until flush() is called.
+     */
+    void beginBatch() noexcept;
+
+    /**
+     * This method ends a batch and sends all queued Envelopes.
+     */
+    void flush() noexcept;
+
+    /**
+     * This method enables or disables wrapping every call of a delegate
+     * passed to timeTrigger in beginBatch() and flush().
+     *
+     * @param enabled true to send all Envelopes of one time slice at once.
+     */
+    void batchTimeTrigger(bool enabled) noexcept;
+
+    /**
+     * This method enables or disables splitting Envelopes that are too large
+     * for one UDP datagram into fragments. Without fragmentation, such
+     * Envelopes are not sent. Received fragments are always reassembled.
+     *
+     * @param enabled true to send large Envelopes as fragments.
+     */
+    void fragmentLargeEnvelopes(bool enabled) noexcept;
+
+    /**
+     * @return Statistics about the reassembly of received fragments.
+     */
+    FragmentReassemblerStatistics fragmentStatistics() noexcept;
+
+    /**
+     * This method enables or disables the delivery of sent Envelopes to other
+     * OD4Sessions on this host; it is enabled by default. Disabling it saves
+     * co-located processes from receiving every Envelope sent from here when
+     * all peers run on other hosts.
+     *
+     * @param enabled true to deliver sent Envelopes to OD4Sessions on this host.
+     * @return true if the option could be set.
+     */
+    bool multicastLoopback(bool enabled) noexcept;
+
+    /**
+     * This method enables or disables dropping Envelopes without a matching
+     * dataTrigger already in the kernel using a BPF socket filter (Linux only);
+     * the filter is regenerated whenever the data triggers change. It cannot
+     * be used together with a "catch-all" delegate.
+     *
+     * @param enabled true to let the kernel drop unwanted Envelopes.
+     * @return true if the filter could be attached or detached.
+     */
+    bool kernelDataTypeFilter(bool enabled) noexcept;
+
+    /**
+     * This method creates a dispatch lane, i.e., a queue and a thread of its
+     * own, that calls the data-triggered delegates of the given dataTypes.
+     * When the first lane is created, a bulk lane is created as well that
+     * calls the delegates of all other dataTypes; thus, the receiving threads
+     * only decode and route Envelopes and a slow delegate delays only the
+     * Envelopes in its own lane. Envelopes of one dataType are delivered in
+     * order; delegates in different lanes are called in parallel and need to
+     * be thread-safe. Dispatch lanes cannot be used with a "catch-all" delegate.
+     * A dataType cannot be moved to another lane as pending Envelopes would be
+     * delivered out of order. Each lane holds at most 1024 pending Envelopes;
+     * when full, the receiving thread waits for the lane's delegates.
+     *
+     * @param dataTypes Message identifiers whose delegates are called in the new lane.
+     * @param realtimePriority SCHED_FIFO priority [1 .. 99] of the lane's thread; 0 keeps the default scheduling.
+     * @param cpu CPU to pin the lane's thread to (Linux only); -1 for no affinity.
+     * @return true if the lane could be created with the given scheduling and none of the dataTypes
+     *         was assigned to a lane before; otherwise, nothing is changed.
+     */
+    bool dispatchLane(const std::vector<int32_t> &dataTypes, int32_t realtimePriority = 0, int32_t cpu = -1) noexcept;
+
+    /**
+     * @return Counters of the dispatch lanes, starting with the bulk lane; maxQueueDepth
+     *         is the high-water mark of pending Envelopes. Empty if no lane was created.
+     */
+    std::vector<NotifyingPipelineStatistics> laneStatistics() noexcept;
+
+    /**
+     * This method selects how received Envelopes are time-stamped (cf. UDPReceiver::setTimeStampMode).
+     *
+     * @param mode Source of the time stamps stored in Envelope.received.
+     * @return true if the mode could be set for all receiving sockets.
+     */
+    bool timeStampMode(ReceiveTimeStampMode mode) noexcept;
+
+    /**
+     * @return Histogram of the latency between receiving an Envelope and calling its delegate; disabled by default.
+     */
+    LatencyHistogram &deliveryLatency() noexcept;
+
+    /**
+     * @return Histogram of the latency between sending and receiving an Envelope; disabled by default.
+     */
+    LatencyHistogram &transportLatency() noexcept;
+
     /**
      * This method sets a delegate to be called data-triggered on arrival
      * of a new Envelope for a given message identifier.
@@ -132,13 +314,14 @@ class LIBCLUON_API OD4Session {
     void send(T &message, const cluon::data::TimeStamp &sampleTimeStamp = cluon::data::TimeStamp(), uint32_t senderStamp = 0) noexcept {
         try {
             std::lock_guard<std::mutex> lck(m_senderMutex);
-            cluon::ToProtoVisitor protoEncoder;
+            // Reuse the encoder's buffer across messages.
+            m_protoEncoder.reset();
 
             cluon::data::Envelope envelope;
             {
                 envelope.dataType(static_cast<int32_t>(message.ID()));
-                message.accept(protoEncoder);
-                envelope.serializedData(protoEncoder.encodedData());
+                message.accept(m_protoEncoder);
+                envelope.serializedData(m_protoEncoder.encodedData());
                 envelope.sent(cluon::time::now());
                 envelope.sampleTimeStamp((0 == (sampleTimeStamp.seconds() + sampleTimeStamp.microseconds())) ? envelope.sent() : sampleTimeStamp);
                 envelope.senderStamp(senderStamp);
@@ -152,19 +335,72 @@ class LIBCLUON_API OD4Session {
     bool isRunning() noexcept;
 
    private:
-    void callback(std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) noexcept;
+    void callback(std::size_t receiver, ReceiveBuffer &&data, uint64_t from, std::chrono::system_clock::time_point &&timepoint) noexcept;
+    void dispatch(const EnvelopeView &view, const std::chrono::system_clock::time_point &timepoint) noexcept;
     void sendInternal(std::string &&dataToSend) noexcept;
+    void appendDatagrams(std::string &&dataToSend, std::vector<std::string> &datagrams) noexcept;
+    void sendDatagrams(std::vector<std::string> &&datagrams) noexcept;
+    bool updateKernelDataTypeFilter() noexcept;
 
    private:
-    std::unique_ptr<cluon::UDPReceiver> m_receiver;
+    class LaneEntry {
+       public:
+        cluon::data::Envelope m_envelope{};
+        std::chrono::system_clock::time_point m_receivedTimePoint{};
+    };
+    void dispatchInLane(LaneEntry &&entry) noexcept;
+
+    // Decoded meta data of a received Envelope; the view points into the bytes held alongside.
+    class DecodedEnvelope {
+       public:
+        ReceiveBuffer m_data{};
+        std::unique_ptr<std::string> m_reassembled{};
+        EnvelopeView m_view{};
+        std::chrono::system_clock::time_point m_receivedTimePoint{};
+    };
+
+   private:
+    std::vector<std::unique_ptr<cluon::UDPReceiver>> m_receivers{};
+    // One pool of workers per receiver if more than one worker is requested.
+    std::vector<std::unique_ptr<cluon::NotifyingPipelinePool<DecodedEnvelope>>> m_workerPools{};
+    std::atomic<bool> m_receiversAreSharded{false};
     cluon::UDPSender m_sender;
 
     std::mutex m_senderMutex{};
+    cluon::ToProtoVisitor m_protoEncoder{};
+
+    std::mutex m_batchMutex{};
+    bool m_isBatching{false};
+    std::vector<std::string> m_batch{};
+    std::atomic<bool> m_batchTimeTrigger{false};
+
+    enum : std::size_t {
+        MAX_DATAGRAM_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                              - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                              - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER),
+        FRAGMENT_TIMEOUT_IN_MILLISECONDS = 1000,
+        MAX_PENDING_FRAGMENT_BYTES       = 64 * 1024 * 1024,
+        RECEIVE_QUEUE_CAPACITY           = 1024,
+        LANE_CAPACITY                    = 1024,
+    };
+    std::atomic<bool> m_fragmentLargeEnvelopes{false};
+    std::atomic<uint32_t> m_nextFragmentedMessageIdentifier{0};
+    FragmentReassembler m_fragmentReassembler{std::chrono::milliseconds(FRAGMENT_TIMEOUT_IN_MILLISECONDS), MAX_PENDING_FRAGMENT_BYTES};
 
     std::function<void(cluon::data::Envelope &&envelope)> m_delegate{nullptr};
+    std::size_t m_numberOfWorkers{1};
+
+    std::atomic<bool> m_kernelDataTypeFilter{false};
+
+    LatencyHistogram m_deliveryLatency{false};
+    LatencyHistogram m_transportLatency{false};
 
     std::mutex m_mapOfDataTriggeredDelegatesMutex{};
     std::unordered_map<int32_t, std::function<void(cluon::data::Envelope &&envelope)>, UseUInt32ValueAsHashKey> m_mapOfDataTriggeredDelegates{};
+
+    // Guarded by m_mapOfDataTriggeredDelegatesMutex; lane 0 is the bulk lane.
+    std::vector<std::unique_ptr<cluon::NotifyingPipeline<LaneEntry>>> m_lanes{};
+    std::unordered_map<int32_t, std::size_t, UseUInt32ValueAsHashKey> m_laneOfDataType{};
 };
 
 } // namespace cluon
@@ -10,8 +10,10 @@
 #define CLUON_PLAYER_HPP
 
 #include "cluon/cluon.hpp"
+#include "cluon/EnvelopeView.hpp"
 #include "cluon/cluonDataStructures.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <fstream>
@@ -22,17 +24,20 @@
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 
 class LIBCLUON_API IndexEntry {
    public:
     IndexEntry() = default;
-    IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept;
+    IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition, const int32_t &dataType = 0, const uint32_t &senderStamp = 0) noexcept;
 
    public:
     int64_t m_sampleTimeStamp{0};
     uint64_t m_filePosition{0};
+    int32_t m_dataType{0};
+    uint32_t m_senderStamp{0};
     bool m_available{0};
 };
 
@@ -44,6 +49,16 @@ class LIBCLUON_API Player {
         MAX_DELAY_IN_MICROSECONDS       = 1 * ONE_SECOND_IN_MICROSECONDS,
         LOOK_AHEAD_IN_S                 = 30,
         MIN_ENTRIES_FOR_LOOK_AHEAD      = 5000,
+        // Sidecar index file (<file>.idx) in little endian: magic, version, size and
+        // modification time of the .rec file, number of entries (header); followed by
+        // sample time stamp, file position, dataType, and senderStamp per entry.
+        INDEX_FILE_MAGIC                = 0x58444943, // "CIDX"
+        INDEX_FILE_VERSION              = 1,
+        INDEX_FILE_HEADER_SIZE          = 2 * 4 + 3 * 8,
+        INDEX_FILE_ENTRY_SIZE           = 2 * 8 + 2 * 4,
+        // The smallest record is the OD4 header of an empty Envelope.
+        MIN_RECORD_SIZE                 = 5,
+        MIN_BYTES_PER_INDEXING_THREAD   = 16 * 1024 * 1024,
     };
 
    private:
@@ -59,8 +74,15 @@ class LIBCLUON_API Player {
      * @param file File to play.
      * @param autoRewind True if the file should be rewind at EOF.
      * @param threading If set to true, player will load new envelopes from the files in background.
+     * @param memoryMapped If set to true, the file is memory-mapped and Envelopes are
+     *                     read directly from the mapping instead of an Envelope cache;
+     *                     threading is not needed in this mode and hence, ignored unless
+     *                     the file cannot be mapped and is read from file instead.
+     *                     Otherwise, files of at least 32 MB are indexed in parallel on
+     *                     machines with several cores through a temporary memory mapping
+     *                     that is released before the first Envelope is read from file.
      */
-    Player(const std::string &file, const bool &autoRewind, const bool &threading) noexcept;
+    Player(const std::string &file, const bool &autoRewind, const bool &threading, const bool &memoryMapped = false) noexcept;
     ~Player();
 
     /**
@@ -69,6 +91,17 @@ class LIBCLUON_API Player {
      */
     std::pair<bool, cluon::data::Envelope> getNextEnvelopeToBeReplayed() noexcept;
 
+    /**
+     * This method returns the next Envelope to be replayed as EnvelopeView.
+     * When the file is memory-mapped, the EnvelopeView references the mapping
+     * directly and is valid as long as this Player exists; otherwise, the
+     * EnvelopeView is only valid until the next call to this method.
+     *
+     * @return Pair of bool and next EnvelopeView to be replayed;
+     *         if bool is false, no next Envelope is available.
+     */
+    std::pair<bool, cluon::EnvelopeView> getNextEnvelopeViewToBeReplayed() noexcept;
+
     /**
      * @return real delay in microseconds to be waited before the next cluon::data::Envelope should be delivered.
      */
@@ -84,17 +117,56 @@ class LIBCLUON_API Player {
      */
     void rewind() noexcept;
 
+    /**
+     * This method seeks to the given relative position in the .rec file.
+     *
+     * @param ratio Relative position in [0, 1].
+     */
     void seekTo(float ratio) noexcept;
 
+    /**
+     * This method seeks to the first Envelope with a sample time stamp
+     * not before the given one using a binary search over the index.
+     *
+     * @param timeStamp Sample time stamp to seek to.
+     */
+    void seekToTimeStamp(const cluon::data::TimeStamp &timeStamp) noexcept;
+
+    /**
+     * This method seeks relative to the sample time stamp of the next
+     * Envelope to be replayed.
+     *
+     * @param microseconds Microseconds to seek forwards (positive) or backwards (negative).
+     */
+    void seekBy(int64_t microseconds) noexcept;
+
     /**
      * @return total amount of cluon::data::Envelopes in the .rec file.
      */
     uint32_t totalNumberOfEnvelopesInRecFile() const noexcept;
 
+    /**
+     * @return Number of indexed cluon::data::Envelopes that could not be read from the .rec file and were skipped.
+     */
+    uint32_t numberOfSkippedEnvelopes() const noexcept;
+
    private:
     // Internal methods without Lock.
     bool hasMoreDataFromRecFile() const noexcept;
 
+    /**
+     * @param sampleTimeStamp Sample time stamp in microseconds.
+     * @return Position of the first entry in the index not before sampleTimeStamp.
+     */
+    std::size_t findPosition(int64_t sampleTimeStamp) const noexcept;
+
+    /**
+     * This method moves the replay position and refills the cache from there.
+     *
+     * @param position Position in the index of the next Envelope to be replayed.
+     */
+    void seekToPosition(std::size_t position) noexcept;
+
     /**
      * This method initializes the global index where the sample
      * time stamps are sorted chronocally and mapped to the
@@ -102,6 +174,72 @@ class LIBCLUON_API Player {
      */
     void initializeIndex() noexcept;
 
+    /**
+     * This method memory-maps the .rec file.
+     *
+     * @return true if the file could be memory-mapped.
+     */
+    bool initializeMemoryMapping() noexcept;
+
+    /**
+     * This method unmaps the memory-mapped .rec file.
+     */
+    void releaseMemoryMapping() noexcept;
+
+    /**
+     * This method creates the global index with positions pointing into
+     * the memory-mapped .rec file. Large files are split into byte ranges
+     * that are indexed in parallel.
+     *
+     * @return Number of bytes indexed.
+     */
+    uint64_t indexMemoryMapping() noexcept;
+
+    /**
+     * This method indexes all consecutive Envelopes starting within [begin, end).
+     *
+     * @param data Memory-mapped .rec file.
+     * @param size Size of the memory-mapped .rec file.
+     * @param begin Position of the first Envelope.
+     * @param end End of the byte range.
+     * @param entries Index entries found in the byte range.
+     * @return Position after the last Envelope, or position of invalid data.
+     */
+    static std::size_t indexRange(const char *data, std::size_t size, std::size_t begin, std::size_t end, std::vector<IndexEntry> &entries) noexcept;
+
+    /**
+     * This method finds the first Envelope within [begin, end) by searching
+     * for the OD4 magic bytes followed by a valid Envelope.
+     *
+     * @param data Memory-mapped .rec file.
+     * @param size Size of the memory-mapped .rec file.
+     * @param begin Beginning of the byte range.
+     * @param end End of the byte range.
+     * @return Position of the first Envelope, or end if none was found.
+     */
+    static std::size_t resynchronize(const char *data, std::size_t size, std::size_t begin, std::size_t end) noexcept;
+
+    /**
+     * This method loads the global index from the sidecar index file
+     * if it matches size and modification time of the .rec file.
+     *
+     * @return true if the index was loaded.
+     */
+    bool loadIndexFile() noexcept;
+
+    /**
+     * This method stores the global index to the sidecar index file.
+     */
+    void storeIndexFile() const noexcept;
+
+    /**
+     * @param file File to query.
+     * @param size Size of the file in bytes.
+     * @param modificationTime Last modification time in nanoseconds.
+     * @return true if the state of the file could be determined.
+     */
+    static bool getRecFileState(const std::string &file, uint64_t &size, int64_t &modificationTime) noexcept;
+
     /**
      * This method computes the initially required amount of
      * cluon::data::Envelope in the cache and fill the cache accordingly.
@@ -142,22 +280,30 @@ class LIBCLUON_API Player {
     std::fstream m_recFile;
     bool m_recFileValid;
 
+    // Memory-mapped .rec file.
+    bool m_memoryMapped;
+    const char *m_mapping;
+    std::size_t m_mappingSize;
+
+    // Serialized Envelope referenced by the last EnvelopeView when not memory-mapped.
+    std::string m_envelopeViewBuffer;
+
    private: // Player states.
     bool m_autoRewind;
 
    private: // Index and cache management.
-    // Global index: Mapping SampleTimeStamp --> cache entry (holding the actual content from .rec file).
+    // Global index: Chronologically sorted entries mapping SampleTimeStamp --> position in .rec file.
     mutable std::mutex m_indexMutex;
-    std::multimap<int64_t, IndexEntry> m_index;
+    std::vector<IndexEntry> m_index;
 
-    // Pointers to the current envelope to be replayed and the
-    // envelope that has be replayed from the global index.
-    std::multimap<int64_t, IndexEntry>::iterator m_previousPreviousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_previousEnvelopeAlreadyReplayed;
-    std::multimap<int64_t, IndexEntry>::iterator m_currentEnvelopeToReplay;
+    // Positions in the global index of the current envelope to be replayed
+    // and the envelope that has be replayed.
+    std::size_t m_previousPreviousEnvelopeAlreadyReplayed;
+    std::size_t m_previousEnvelopeAlreadyReplayed;
+    std::size_t m_currentEnvelopeToReplay;
 
     // Information about the index.
-    std::multimap<int64_t, IndexEntry>::iterator m_nextEntryToReadFromRecFile;
+    std::size_t m_nextEntryToReadFromRecFile;
 
     uint32_t m_desiredInitialLevel;
 
@@ -165,6 +311,9 @@ class LIBCLUON_API Player {
     cluon::data::TimeStamp m_firstTimePointReturningAEnvelope;
     uint64_t m_numberOfReturnedEnvelopesInTotal;
 
+    // Number of entries that could not be decoded when filling the cache.
+    uint64_t m_numberOfSkippedEntries;
+
     uint32_t m_delay;
 
    private:
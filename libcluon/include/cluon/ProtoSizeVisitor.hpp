@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_PROTOSIZEVISITOR_HPP
+#define CLUON_PROTOSIZEVISITOR_HPP
+
+#include "cluon/ProtoConstants.hpp"
+#include "cluon/cluon.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cluon {
+/**
+This class computes the number of bytes that ToProtoVisitor will produce for
+a given message without encoding it. Optionally, the lengths of all nested
+messages are recorded in the order in which they are visited so that an
+encoder can write their length prefixes without encoding them twice.
+
+\code{.cpp}
+MyMessage msg;
+cluon::ProtoSizeVisitor sizeVisitor;
+msg.accept(sizeVisitor);
+std::cout << "Encoded size: " << sizeVisitor.encodedSize() << std::endl;
+\endcode
+*/
+class LIBCLUON_API ProtoSizeVisitor {
+   private:
+    ProtoSizeVisitor(const ProtoSizeVisitor &) = delete;
+    ProtoSizeVisitor(ProtoSizeVisitor &&)      = delete;
+    ProtoSizeVisitor &operator=(const ProtoSizeVisitor &) = delete;
+    ProtoSizeVisitor &operator=(ProtoSizeVisitor &&) = delete;
+
+   public:
+    ProtoSizeVisitor()  = default;
+    ~ProtoSizeVisitor() = default;
+
+    /**
+     * Constructor to record the lengths of nested messages.
+     *
+     * @param nestedSizes Lengths of nested messages are appended in pre-order.
+     */
+    explicit ProtoSizeVisitor(std::vector<std::size_t> &nestedSizes) noexcept;
+
+    /**
+     * @return Number of bytes of the Proto-encoded data.
+     */
+    std::size_t encodedSize() const noexcept;
+
+   public:
+    // The following methods are provided to allow an instance of this class to
+    // be used as visitor for an instance with the method signature void accept<T>(T&);
+
+    void preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept;
+    void postVisit() noexcept;
+
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, char &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, int8_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, uint8_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, int16_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, uint16_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, int32_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, uint32_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, int64_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, uint64_t &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept;
+    void visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept;
+
+    template <typename T>
+    void visit(uint32_t &id, std::string &&typeName, std::string &&name, T &value) noexcept {
+        (void)typeName;
+        (void)name;
+
+        // Reserve the slot for this nested message before visiting its children (pre-order).
+        const std::size_t INDEX{m_nestedSizes->size()};
+        m_nestedSizes->push_back(0);
+
+        const std::size_t SIZE_BEFORE{m_size};
+        value.accept(*this);
+        const std::size_t LENGTH{m_size - SIZE_BEFORE};
+        (*m_nestedSizes)[INDEX] = LENGTH;
+
+        m_size += sizeOfKey(id, ProtoConstants::LENGTH_DELIMITED) + sizeOfVarInt(LENGTH);
+    }
+
+   private:
+    /**
+     * @param v Value to encode.
+     * @return Number of bytes to encode v as VarInt.
+     */
+    std::size_t sizeOfVarInt(uint64_t v) const noexcept;
+
+    /**
+     * @param fieldIdentifier Field identifier.
+     * @param protoType Protobuf type identifier.
+     * @return Number of bytes to encode the key.
+     */
+    std::size_t sizeOfKey(uint32_t fieldIdentifier, ProtoConstants protoType) const noexcept;
+
+   private:
+    std::vector<std::size_t> m_ownNestedSizes{};
+    std::vector<std::size_t> *m_nestedSizes{&m_ownNestedSizes};
+    std::size_t m_size{0};
+};
+} // namespace cluon
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_REACTOR_HPP
+#define CLUON_REACTOR_HPP
+
+#include "cluon/cluon.hpp"
+
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cluon {
+/**
+This class provides an event loop that multiplexes many sockets on one or a
+few threads. Whenever a registered file descriptor becomes readable, its
+delegate is called from one of the event loop's threads; the delegate for one
+file descriptor is never called concurrently. The shared instance runs one
+thread unless the environment variable CLUON_REACTOR_THREADS specifies more. On Linux, the event loop waits on epoll without
+any timeout and is woken up immediately via an eventfd when it shall stop. On
+other platforms, the event loop is not available and isRunning() returns false;
+classes registering with it fall back to their own threads in this case.
+
+UDPReceiver, TCPConnection, and TCPServer register with the shared instance
+returned by Reactor::instance():
+
+\code{.cpp}
+cluon::Reactor::instance().add(socket, [](){ // read from socket });
+
+// Unregister; blocks until a running delegate for this socket has returned.
+cluon::Reactor::instance().remove(socket);
+\endcode
+
+As all delegates share the event loop's threads, they must not block. Instead,
+a delegate that cannot hand over further data pauses its file descriptor and
+resumes it once its consumer has made room.
+*/
+class LIBCLUON_API Reactor {
+   private:
+    Reactor(const Reactor &) = delete;
+    Reactor(Reactor &&)      = delete;
+    Reactor &operator=(const Reactor &) = delete;
+    Reactor &operator=(Reactor &&) = delete;
+
+   public:
+    /**
+     * Define singleton behavior using static initializer (cf. http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2011/n3242.pdf, Sec. 6.7.4).
+     * @return singleton for an instance of this class.
+     */
+    static Reactor &instance() noexcept {
+        static Reactor instance(numberOfThreadsFromEnvironment());
+        return instance;
+    }
+
+    /**
+     * Constructor.
+     *
+     * @param numberOfThreads Number of threads waiting for and dispatching events (at least 1).
+     */
+    Reactor(std::size_t numberOfThreads = 1) noexcept;
+    ~Reactor() noexcept;
+
+    /**
+     * @return true if the event loop is running.
+     */
+    bool isRunning() const noexcept;
+
+    /**
+     * @return Number of threads dispatching events.
+     */
+    std::size_t numberOfThreads() const noexcept;
+
+    /**
+     * This method registers a delegate to be called whenever the given file
+     * descriptor is readable.
+     *
+     * @param fd File descriptor to watch.
+     * @param delegate Function to call from the event loop's thread.
+     * @return true if the file descriptor could be registered.
+     */
+    bool add(int32_t fd, std::function<void()> delegate) noexcept;
+
+    /**
+     * This method unregisters a file descriptor. Unless called from a
+     * delegate, this method blocks until a currently running delegate for
+     * the file descriptor has returned.
+     *
+     * @param fd File descriptor to remove.
+     * @return true if the file descriptor was registered.
+     */
+    bool remove(int32_t fd) noexcept;
+
+    /**
+     * This method stops calling the delegate for a registered file descriptor
+     * until resume is called; data arriving meanwhile stays in the socket.
+     *
+     * @param fd File descriptor to pause.
+     * @return true if the file descriptor is registered.
+     */
+    bool pause(int32_t fd) noexcept;
+
+    /**
+     * This method resumes calling the delegate for a paused file descriptor.
+     *
+     * @param fd File descriptor to resume.
+     * @return true if the file descriptor is registered.
+     */
+    bool resume(int32_t fd) noexcept;
+
+   private:
+    static std::size_t numberOfThreadsFromEnvironment() noexcept;
+    bool isEventLoopThread() const noexcept;
+    void arm(int32_t fd, bool readable) noexcept;
+    void processEvents() noexcept;
+
+   private:
+    int32_t m_epollFD{-1};
+    int32_t m_eventFD{-1};
+
+    // With several threads, a file descriptor is disarmed while its delegate runs.
+    bool m_isOneShot{false};
+
+    std::atomic<bool> m_processEventsThreadRunning{false};
+    std::atomic<std::size_t> m_numberOfStartedThreads{0};
+    std::vector<std::thread> m_processEventsThreads{};
+
+    std::mutex m_delegatesMutex{};
+    std::condition_variable m_delegatesCondition{};
+    std::unordered_map<int32_t, std::shared_ptr<std::function<void()>>> m_delegates{};
+    std::unordered_set<int32_t> m_dispatchingFDs{};
+    std::unordered_set<int32_t> m_pausedFDs{};
+};
+} // namespace cluon
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_RECEIVEBUFFER_HPP
+#define CLUON_RECEIVEBUFFER_HPP
+
+#include "cluon/cluon.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cluon {
+
+class ReceiveBufferPool;
+
+/**
+This class is a move-only handle to a fixed-size slab from a ReceiveBufferPool.
+The slab is returned to its pool when the handle is destroyed; thus, received
+bytes can be handed over to delegates without allocating memory per datagram.
+*/
+class LIBCLUON_API ReceiveBuffer {
+   private:
+    ReceiveBuffer(const ReceiveBuffer &) = delete;
+    ReceiveBuffer &operator=(const ReceiveBuffer &) = delete;
+
+   public:
+    ReceiveBuffer() = default;
+    ReceiveBuffer(ReceiveBuffer &&other) noexcept;
+    ReceiveBuffer &operator=(ReceiveBuffer &&other) noexcept;
+    ~ReceiveBuffer() noexcept;
+
+    /**
+     * @return Pointer to the slab or nullptr if this handle is empty.
+     */
+    char *data() noexcept;
+    const char *data() const noexcept;
+
+    /**
+     * @return Number of valid bytes in the slab.
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * This method sets the number of valid bytes (limited to the capacity).
+     *
+     * @param size Number of valid bytes.
+     */
+    void size(std::size_t size) noexcept;
+
+    /**
+     * @return Size of the slab.
+     */
+    std::size_t capacity() const noexcept;
+
+    /**
+     * @return Copy of the valid bytes.
+     */
+    std::string toString() const noexcept;
+
+   private:
+    friend class ReceiveBufferPool;
+    ReceiveBuffer(std::shared_ptr<ReceiveBufferPool> pool, std::unique_ptr<char[]> &&slab, std::size_t capacity) noexcept;
+    void release() noexcept;
+
+   private:
+    std::shared_ptr<ReceiveBufferPool> m_pool{nullptr};
+    std::unique_ptr<char[]> m_slab{nullptr};
+    std::size_t m_capacity{0};
+    std::size_t m_size{0};
+};
+
+/**
+This class manages fixed-size slabs that are recycled when the ReceiveBuffer
+handles referring to them are destroyed. Up to maxFreeSlabs are kept for reuse;
+additional slabs are allocated on demand and freed when returned. A pool must
+be created with std::make_shared as handles keep their pool alive.
+*/
+class LIBCLUON_API ReceiveBufferPool : public std::enable_shared_from_this<ReceiveBufferPool> {
+   private:
+    ReceiveBufferPool(const ReceiveBufferPool &) = delete;
+    ReceiveBufferPool(ReceiveBufferPool &&)      = delete;
+    ReceiveBufferPool &operator=(const ReceiveBufferPool &) = delete;
+    ReceiveBufferPool &operator=(ReceiveBufferPool &&) = delete;
+
+   public:
+    /**
+     * Constructor.
+     *
+     * @param slabSize Size of each slab in bytes.
+     * @param maxFreeSlabs Maximum number of slabs kept for reuse.
+     */
+    ReceiveBufferPool(std::size_t slabSize, std::size_t maxFreeSlabs) noexcept;
+
+    /**
+     * @return Handle to a slab from this pool; the handle is empty if no memory could be allocated.
+     */
+    ReceiveBuffer acquire() noexcept;
+
+    /**
+     * @return Size of each slab in bytes.
+     */
+    std::size_t slabSize() const noexcept;
+
+    /**
+     * @return Number of slabs currently available for reuse.
+     */
+    std::size_t numberOfFreeSlabs() noexcept;
+
+    /**
+     * @return Number of slabs allocated so far.
+     */
+    uint64_t numberOfAllocatedSlabs() noexcept;
+
+   private:
+    friend class ReceiveBuffer;
+    void release(std::unique_ptr<char[]> &&slab) noexcept;
+
+   private:
+    const std::size_t m_slabSize;
+    const std::size_t m_maxFreeSlabs;
+
+    std::mutex m_freeSlabsMutex{};
+    std::vector<std::unique_ptr<char[]>> m_freeSlabs{};
+    uint64_t m_numberOfAllocatedSlabs{0};
+};
+} // namespace cluon
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef CLUON_SOCKETFILTER_HPP
+#define CLUON_SOCKETFILTER_HPP
+
+#include "cluon/cluon.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cluon {
+/**
+One instruction of a classic BPF program; the layout matches Linux' struct
+sock_filter so that a program can be attached to a socket as it is.
+*/
+struct LIBCLUON_API SocketFilterInstruction {
+    enum : uint16_t {
+        LOAD_BYTE_ABSOLUTE     = 0x30, // BPF_LD | BPF_B | BPF_ABS
+        LOAD_HALFWORD_ABSOLUTE = 0x28, // BPF_LD | BPF_H | BPF_ABS
+        MULTIPLY               = 0x24, // BPF_ALU | BPF_MUL | BPF_K
+        SHIFT_RIGHT            = 0x74, // BPF_ALU | BPF_RSH | BPF_K
+        ADD_X                  = 0x0C, // BPF_ALU | BPF_ADD | BPF_X
+        MODULO                 = 0x94, // BPF_ALU | BPF_MOD | BPF_K
+        COPY_A_TO_X            = 0x07, // BPF_MISC | BPF_TAX
+        JUMP_IF_EQUAL          = 0x15, // BPF_JMP | BPF_JEQ | BPF_K
+        RETURN                 = 0x06, // BPF_RET | BPF_K
+    };
+    enum : uint32_t {
+        DROP   = 0,
+        ACCEPT = 0xFFFFFFFF,
+    };
+    enum : std::size_t {
+        MAX_INSTRUCTIONS = 4096, // BPF_MAXINSNS
+    };
+
+    uint16_t code{0};
+    uint8_t jt{0};
+    uint8_t jf{0};
+    uint32_t k{0};
+};
+
+/**
+ * This method creates a classic BPF program for sockets receiving OD4-framed
+ * Envelopes via UDP. The program accepts only Envelopes whose dataType is
+ * contained in the given list by comparing the varint-encoded dataType at its
+ * fixed position right after the OD4 header (0x0D 0xA4 LEN0 LEN1 LEN2 0x08).
+ * Fragments and datagrams that are not OD4-framed are always accepted.
+ *
+ * @param dataTypes List of dataTypes to accept.
+ * @return BPF program or an empty list if the list of dataTypes is too long.
+ */
+LIBCLUON_API std::vector<SocketFilterInstruction> createEnvelopeDataTypeFilter(const std::vector<int32_t> &dataTypes) noexcept;
+
+/**
+ * This method creates a classic BPF program that lets several sockets
+ * receiving the same OD4-framed Envelopes via UDP multicast share the load:
+ * Each socket accepts only the Envelopes of its shard, which is computed from
+ * the first two bytes of the encoded dataType; thus, all Envelopes with the
+ * same dataType end up in the same shard and small consecutive dataTypes are
+ * spread evenly over the shards. Fragments are assigned to shards by
+ * their sender's port and other datagrams are accepted by shard 0 only.
+ *
+ * @param shard Shard to accept [0 .. numberOfShards - 1].
+ * @param numberOfShards Number of sockets sharing the load.
+ * @param dataTypes List of dataTypes to accept in addition; only used when filterDataTypes is true.
+ * @param filterDataTypes true to accept only Envelopes with a dataType from the list.
+ * @return BPF program or an empty list if the list of dataTypes is too long or the shard is invalid.
+ */
+LIBCLUON_API std::vector<SocketFilterInstruction> createEnvelopeShardFilter(uint32_t shard,
+                                                                            uint32_t numberOfShards,
+                                                                            const std::vector<int32_t> &dataTypes,
+                                                                            bool filterDataTypes) noexcept;
+} // namespace cluon
+
+#endif
@@ -29,6 +29,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace cluon {
 /**
@@ -140,8 +141,23 @@ class LIBCLUON_API TCPConnection {
      */
     void closeSocket(int errorCode) noexcept;
     void startReadingFromSocket() noexcept;
+    void registerWithReactor() noexcept;
     void readFromSocket() noexcept;
 
+    /**
+     * This method reads available data from the socket and hands it to the pipeline.
+     *
+     * @return false if the connection was lost.
+     */
+    bool readData() noexcept;
+
+    /**
+     * This method moves the pending entry into the queue once the delegate
+     * has emptied it to half of its capacity and resumes the paused socket;
+     * called with m_pendingEntryMutex held.
+     */
+    void resumeReadingIfDrained() noexcept;
+
    private:
     mutable std::mutex m_socketMutex{};
     int32_t m_socket{-1};
@@ -150,6 +166,9 @@ class LIBCLUON_API TCPConnection {
 
     std::atomic<bool> m_readFromSocketThreadRunning{false};
     std::thread m_readFromSocketThread{};
+    bool m_usesReactor{false};
+    std::atomic<bool> m_isRegisteredWithReactor{false};
+    std::vector<char> m_buffer{};
 
     std::mutex m_newDataDelegateMutex{};
     std::function<void(std::string &&, std::chrono::system_clock::time_point)> m_newDataDelegate{};
@@ -165,6 +184,15 @@ class LIBCLUON_API TCPConnection {
     };
 
     std::shared_ptr<cluon::NotifyingPipeline<PipelineEntry>> m_pipeline{};
+
+    enum : std::size_t {
+        QUEUE_CAPACITY = 1024,
+    };
+
+    // Entry not fitting into the full queue while the socket is paused in the shared event loop.
+    std::mutex m_pendingEntryMutex{};
+    PipelineEntry m_pendingEntry{};
+    std::atomic<bool> m_isPaused{false};
 };
 } // namespace cluon
 
@@ -61,6 +61,7 @@ class LIBCLUON_API TCPServer {
      */
     void closeSocket(int errorCode) noexcept;
     void readFromSocket() noexcept;
+    void acceptConnection() noexcept;
 
    private:
     mutable std::mutex m_socketMutex{};
@@ -68,6 +69,7 @@ class LIBCLUON_API TCPServer {
 
     std::atomic<bool> m_readFromSocketThreadRunning{false};
     std::thread m_readFromSocketThread{};
+    bool m_isRegisteredWithReactor{false};
 
     std::mutex m_newConnectionDelegateMutex{};
     std::function<void(std::string &&from, std::shared_ptr<cluon::TCPConnection> connection)> m_newConnectionDelegate{};
@@ -10,11 +10,14 @@
 #define CLUON_TOPROTOVISITOR_HPP
 
 #include "cluon/ProtoConstants.hpp"
+#include "cluon/ProtoSizeVisitor.hpp"
 #include "cluon/cluon.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -31,11 +34,43 @@ class LIBCLUON_API ToProtoVisitor {
     ToProtoVisitor()  = default;
     ~ToProtoVisitor() = default;
 
+    /**
+     * Constructor to encode into a caller-supplied buffer. Encoded data is
+     * appended to the bytes already contained in buffer, which must outlive
+     * this instance.
+     *
+     * @param buffer Growable buffer to append the encoded data to.
+     */
+    explicit ToProtoVisitor(std::string &buffer) noexcept;
+
     /**
      * @return Encoded data in Proto format.
      */
     std::string encodedData() const noexcept;
 
+    /**
+     * @return Number of bytes encoded so far.
+     */
+    std::size_t encodedSize() const noexcept;
+
+    /**
+     * This method discards the encoded data while keeping the allocated
+     * memory so that this instance can be reused for the next message.
+     */
+    void reset() noexcept;
+
+    /**
+     * These methods map signed values to unsigned ones using ZigZag encoding
+     * so that small negative values result in short VarInts.
+     *
+     * @param v Value to map.
+     * @return ZigZag-encoded value.
+     */
+    static uint8_t toZigZag8(int8_t v) noexcept;
+    static uint16_t toZigZag16(int16_t v) noexcept;
+    static uint32_t toZigZag32(int32_t v) noexcept;
+    static uint64_t toZigZag64(int64_t v) noexcept;
+
    public:
     // The following methods are provided to allow an instance of this class to
     // be used as visitor for an instance with the method signature void accept<T>(T&);
@@ -62,40 +97,45 @@ class LIBCLUON_API ToProtoVisitor {
         (void)typeName;
         (void)name;
 
-        toVarInt(m_buffer, std::move(encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED))));
-        cluon::ToProtoVisitor nestedProtoEncoder;
-        value.accept(nestedProtoEncoder);
-        encode(m_buffer, std::move(nestedProtoEncoder.encodedData()));
+        if (m_nestedSizesIndex >= m_nestedSizes.size()) {
+            // First pass: compute the lengths of this nested message and of
+            // all messages nested therein at once.
+            m_nestedSizes.clear();
+            m_nestedSizesIndex = 0;
+            cluon::ProtoSizeVisitor sizeVisitor{m_nestedSizes};
+            sizeVisitor.visit(id, std::move(typeName), std::move(name), value);
+            m_buffer->reserve(m_buffer->size() + sizeVisitor.encodedSize());
+        }
+
+        // Second pass: write the length prefix and encode the nested message in place.
+        toVarInt(*m_buffer, encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED)));
+        toVarInt(*m_buffer, m_nestedSizes[m_nestedSizesIndex++]);
+        value.accept(*this);
     }
 
    private:
-    std::size_t encode(std::ostream &o, bool &v) noexcept;
-    std::size_t encode(std::ostream &o, int8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint8_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint16_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint32_t &v) noexcept;
-    std::size_t encode(std::ostream &o, int64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, uint64_t &v) noexcept;
-    std::size_t encode(std::ostream &o, float &v) noexcept;
-    std::size_t encode(std::ostream &o, double &v) noexcept;
-    std::size_t encode(std::ostream &o, const std::string &v) noexcept;
+    std::size_t encode(std::string &o, bool &v) noexcept;
+    std::size_t encode(std::string &o, int8_t &v) noexcept;
+    std::size_t encode(std::string &o, uint8_t &v) noexcept;
+    std::size_t encode(std::string &o, int16_t &v) noexcept;
+    std::size_t encode(std::string &o, uint16_t &v) noexcept;
+    std::size_t encode(std::string &o, int32_t &v) noexcept;
+    std::size_t encode(std::string &o, uint32_t &v) noexcept;
+    std::size_t encode(std::string &o, int64_t &v) noexcept;
+    std::size_t encode(std::string &o, uint64_t &v) noexcept;
+    std::size_t encode(std::string &o, float &v) noexcept;
+    std::size_t encode(std::string &o, double &v) noexcept;
+    std::size_t encode(std::string &o, const std::string &v) noexcept;
 
    private:
-    uint8_t toZigZag8(int8_t v) noexcept;
-    uint16_t toZigZag16(int16_t v) noexcept;
-    uint32_t toZigZag32(int32_t v) noexcept;
-    uint64_t toZigZag64(int64_t v) noexcept;
-
     /**
      * This method encodes a given value in VarInt.
      *
-     * @param out std::ostream to encode to.
+     * @param out Buffer to append the encoded value to.
      * @param v Value to encode.
      * @return Bytes written.
      */
-    std::size_t toVarInt(std::ostream &out, uint64_t v) noexcept;
+    std::size_t toVarInt(std::string &out, uint64_t v) noexcept;
 
     /**
      * This method creates a key/value pair encoded in Proto format.
@@ -108,8 +148,8 @@ class LIBCLUON_API ToProtoVisitor {
     std::size_t toKeyValue(uint32_t fieldIdentifier, T &v) noexcept {
         std::size_t size{0};
         uint64_t key = encodeKey(fieldIdentifier, static_cast<uint8_t>(ProtoConstants::VARINT));
-        size += toVarInt(m_buffer, key);
-        size += encode(m_buffer, v);
+        size += toVarInt(*m_buffer, key);
+        size += encode(*m_buffer, v);
         return size;
     }
 
@@ -123,7 +163,13 @@ class LIBCLUON_API ToProtoVisitor {
     uint64_t encodeKey(uint32_t fieldIdentifier, uint8_t protoType) noexcept;
 
    private:
-    std::stringstream m_buffer{""};
+    std::string m_ownBuffer{};
+    std::string *m_buffer{&m_ownBuffer};
+    std::size_t m_start{0};
+
+    // Lengths of nested messages in the order of encoding (cf. ProtoSizeVisitor).
+    std::vector<std::size_t> m_nestedSizes{};
+    std::size_t m_nestedSizesIndex{0};
 };
 } // namespace cluon
 
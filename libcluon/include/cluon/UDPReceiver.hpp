@@ -9,7 +9,13 @@
 #ifndef CLUON_UDPRECEIVER_HPP
 #define CLUON_UDPRECEIVER_HPP
 
+#include "cluon/IPv4Tools.hpp"
+#include "cluon/LatencyHistogram.hpp"
 #include "cluon/NotifyingPipeline.hpp"
+#include "cluon/NotifyingPipelinePool.hpp"
+#include "cluon/ReceiveBuffer.hpp"
+#include "cluon/SocketFilter.hpp"
+#include "cluon/UDPPacketSizeConstraints.hpp"
 #include "cluon/cluon.hpp"
 
 // clang-format off
@@ -22,18 +28,30 @@
 // clang-format on
 
 #include <cstdint>
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <deque>
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace cluon {
+
+/**
+ * Source of the time stamp handed to the delegate of a UDPReceiver.
+ */
+enum class ReceiveTimeStampMode : uint8_t {
+    USER_SPACE = 0, // Time point when the datagram was read from the socket.
+    SOFTWARE   = 1, // Time point when the kernel received the datagram (SO_TIMESTAMPNS).
+    HARDWARE   = 2, // Time point when the network card received the datagram (SO_TIMESTAMPING); kernel time otherwise.
+};
+
 /**
 To receive data from a UDP socket, simply include the header
 `#include <cluon/UDPReceiver.hpp>`.
@@ -63,11 +81,54 @@ cluon::UDPReceiver receiver("127.0.0.1", 1234,
     });
 \endcode
 
+To avoid allocating memory per datagram, a delegate with the signature
+`std::function<void(cluon::ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&) noexcept>`
+can be used instead: The first parameter is a handle to a pooled buffer that
+is recycled as soon as the handle is destroyed and the second parameter is
+the compact sender address (cf. cluon::decodeSenderAddress):
+
+\code{.cpp}
+cluon::UDPReceiver receiver("127.0.0.1", 1234,
+    [](cluon::ReceiveBuffer &&data, uint64_t sender, std::chrono::system_clock::time_point &&ts) noexcept {
+        std::cout << "Received " << data.size() << " bytes"
+                  << " from " << cluon::decodeSenderAddress(sender) << std::endl;
+    }, 0);
+\endcode
+
 After creating an instance of class `cluon::UDPReceiver`, it is immediately
-activated and concurrently waiting for data in a separate thread. To check
+activated and concurrently waiting for data, either in the shared event loop
+provided by cluon::Reactor or, if not available, in a separate thread. To check
 whether the instance was created successfully and running, the method
 `isRunning()` should be called.
 
+By default, the delegate is called from one thread. For CPU-heavy delegates,
+a number of worker threads can be specified; received bytes with the same
+ordering key (by default, the sender) are handed to the delegate in the
+order of their arrival while bytes with different keys are processed in
+parallel. The delegate needs to be thread-safe in this case.
+
+Received datagrams wait for the delegate in a lock-free queue holding up to
+1024 datagrams per worker. When the queue is full because the delegate is
+slower than the sender, reading from the socket stops until the delegate has
+made room; meanwhile, new datagrams wait in the socket's receive buffer where
+the kernel drops them once it is full. In the shared event loop, the socket is
+paused instead of blocking so that other sockets are still served; it is
+resumed once the delegate has emptied the queue to half of its capacity. Passing a queueCapacity of 0 selects
+an unbounded queue instead that never stops reading but grows without limit.
+
+Datagrams are received into slabs of the maximum datagram size (64 KiB);
+datagrams of up to 2 KiB are then copied into small slabs so that a full
+queue of 1024 such datagrams holds about 2 MiB. Larger datagrams are handed
+over in their slab without copying; in the worst case, a full queue of them
+holds queueCapacity * numberOfWorkers * 64 KiB (64 MiB per 1024 entries).
+Slabs are recycled; up to one queue's worth of small slabs is kept for reuse.
+
+On Linux, the time stamp is taken by the kernel with nanosecond resolution
+and delivered with the datagram; setTimeStampMode selects whether it is taken
+in user space, by the kernel, or by the network card. The latency between the
+time stamp and calling the delegate is recorded in deliveryLatency() once
+it is enabled.
+
 A complete example is available
 [here](https://github.com/chrberger/libcluon/blob/master/libcluon/examples/cluon-UDPReceiver.cpp).
 */
@@ -86,11 +147,38 @@ class LIBCLUON_API UDPReceiver {
      * @param receiveFromPort Port to receive UDP packets from.
      * @param delegate Functional (noexcept) to handle received bytes; parameters are received data, sender, timestamp.
      * @param localSendFromPort Port that an application is using to send data. This port (> 0) is ignored when data is received.
+     * @param numberOfWorkers Number of threads calling the delegate.
+     * @param orderingKey Function returning the ordering key for received bytes and sender; if nullptr, the sender is used.
+     * @param queueCapacity Maximum number of datagrams waiting for the delegate per worker; 0 for an unbounded queue.
      */
     UDPReceiver(const std::string &receiveFromAddress,
                 uint16_t receiveFromPort,
                 std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
-                uint16_t localSendFromPort = 0) noexcept;
+                uint16_t localSendFromPort  = 0,
+                std::size_t numberOfWorkers = 1,
+                std::function<std::size_t(const ReceiveBuffer &, uint64_t)> orderingKey = nullptr,
+                std::size_t queueCapacity                                               = 1024) noexcept;
+
+    /**
+     * Constructor for a delegate receiving pooled buffers.
+     *
+     * @param receiveFromAddress Numerical IPv4 address to receive UDP packets from.
+     * @param receiveFromPort Port to receive UDP packets from.
+     * @param delegate Functional (noexcept) to handle received bytes; parameters are received data, compact sender address, timestamp.
+     * @param localSendFromPort Port that an application is using to send data. This port (> 0) is ignored when data is received.
+     * @param numberOfWorkers Number of threads calling the delegate.
+     * @param orderingKey Function returning the ordering key for received bytes and sender; if nullptr, the sender is used.
+     * @param queueCapacity Maximum number of datagrams waiting for the delegate per worker; 0 for an unbounded queue.
+     * @param socketFilter BPF program attached before the socket is bound so that no datagram bypasses it (cf. setSocketFilter).
+     */
+    UDPReceiver(const std::string &receiveFromAddress,
+                uint16_t receiveFromPort,
+                std::function<void(ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&)> delegate,
+                uint16_t localSendFromPort,
+                std::size_t numberOfWorkers = 1,
+                std::function<std::size_t(const ReceiveBuffer &, uint64_t)> orderingKey = nullptr,
+                std::size_t queueCapacity                                               = 1024,
+                const std::vector<SocketFilterInstruction> &socketFilter                = {}) noexcept;
     ~UDPReceiver() noexcept;
 
     /**
@@ -98,6 +186,45 @@ class LIBCLUON_API UDPReceiver {
      */
     bool isRunning() const noexcept;
 
+    /**
+     * @return true if the kernel may coalesce datagrams of equal size (UDP_GRO); they are split before calling the delegate.
+     */
+    bool hasReceiveOffload() const noexcept;
+
+    /**
+     * This method attaches a classic BPF program to the socket so that the
+     * kernel drops unwanted datagrams before they are copied (Linux only).
+     * As a filter only sees the first of coalesced datagrams, receive offload
+     * is disabled while a filter is attached.
+     *
+     * @param program BPF program to attach; an empty program detaches the current one.
+     * @return true if the program could be attached or detached.
+     */
+    bool setSocketFilter(const std::vector<SocketFilterInstruction> &program) noexcept;
+
+    /**
+     * This method selects how received datagrams are time-stamped; the default
+     * is ReceiveTimeStampMode::SOFTWARE on Linux and USER_SPACE elsewhere.
+     * Hardware time stamps require a network card that was configured to
+     * time-stamp all received packets (e.g., using hwstamp_ctl) and are taken
+     * from its clock, which needs to be synchronized to the system clock
+     * (e.g., using phc2sys); datagrams without one get the kernel's time stamp.
+     *
+     * @param mode Source of the time stamps.
+     * @return true if the mode could be set.
+     */
+    bool setTimeStampMode(ReceiveTimeStampMode mode) noexcept;
+
+    /**
+     * @return Source of the time stamps.
+     */
+    ReceiveTimeStampMode timeStampMode() const noexcept;
+
+    /**
+     * @return Histogram of the latency between receiving a datagram and calling the delegate; disabled by default.
+     */
+    LatencyHistogram &deliveryLatency() noexcept;
+
    private:
     /**
      * This method closes the socket.
@@ -108,10 +235,61 @@ class LIBCLUON_API UDPReceiver {
 
     void readFromSocket() noexcept;
 
+    /**
+     * This method reads all pending datagrams from the socket and hands them to the pipeline.
+     */
+    void readDatagrams() noexcept;
+
+    /**
+     * This method stores the local IPv4 addresses in an open-addressing hash
+     * table that is at most half full; thus, a lookup needs O(1) probes.
+     *
+     * @param localIPAddresses Local IPv4 addresses in network byte order.
+     */
+    void setLocalIPAddresses(const std::vector<uint32_t> &localIPAddresses) noexcept;
+
+    /**
+     * @param remote Sender of received bytes.
+     * @return true if the bytes were sent from our local send-from port on this host.
+     */
+    bool isSentFromUs(const struct sockaddr_in &remote) const noexcept;
+
+    /**
+     * This method hands received bytes to the pipeline.
+     *
+     * @param data Received bytes.
+     * @param remote Sender of the bytes.
+     * @param timestamp Time point when the bytes were received.
+     */
+    void handleReceivedBytes(ReceiveBuffer &&data, const struct sockaddr_in &remote, std::chrono::system_clock::time_point &&timestamp) noexcept;
+
+    /**
+     * This method copies small received bytes into a small slab; larger ones
+     * are moved out of the given slab.
+     *
+     * @param received Slab holding the received bytes.
+     * @return Slab to be handed to the pipeline.
+     */
+    ReceiveBuffer toRightSizedBuffer(ReceiveBuffer &received) noexcept;
+
+    /**
+     * This method pauses the socket in the shared event loop after the queue
+     * has been filled; called only from the event loop.
+     */
+    void pauseReading() noexcept;
+
+    /**
+     * This method moves the backlog into the queue once the delegate has
+     * emptied it to half of its capacity and resumes the paused socket;
+     * called with m_backlogMutex held.
+     */
+    void resumeReadingIfDrained() noexcept;
+
    private:
     int32_t m_socket{-1};
     bool m_isBlockingSocket{true};
-    std::set<unsigned long> m_listOfLocalIPAddresses{};
+    std::vector<uint32_t> m_localIPAddresses{}; // Hash table; empty slots are 0.
+    uint32_t m_localIPAddressesShift{31};
     uint16_t m_localSendFromPort;
     struct sockaddr_in m_receiveFromAddress {};
     struct ip_mreq m_mreq {};
@@ -119,19 +297,41 @@ class LIBCLUON_API UDPReceiver {
 
     std::atomic<bool> m_readFromSocketThreadRunning{false};
     std::thread m_readFromSocketThread{};
+    bool m_isRegisteredWithReactor{false};
+    bool m_hasReceiveOffload{false};
+    std::atomic<ReceiveTimeStampMode> m_timeStampMode{ReceiveTimeStampMode::USER_SPACE};
+    LatencyHistogram m_deliveryLatency{false};
+
+    enum : std::size_t {
+        MAX_DATAGRAM_LENGTH = static_cast<std::size_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                              - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                              - static_cast<std::size_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER),
+        SMALL_DATAGRAM_LENGTH     = 2048,
+        MAX_DATAGRAMS_PER_RECEIVE = 16,
+    };
+    std::shared_ptr<ReceiveBufferPool> m_receiveBufferPool{};
+    std::shared_ptr<ReceiveBufferPool> m_smallReceiveBufferPool{};
+    std::array<ReceiveBuffer, MAX_DATAGRAMS_PER_RECEIVE> m_receiveBuffers{};
 
    private:
-    std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point)> m_delegate{};
+    std::function<void(ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&)> m_delegate{};
 
    private:
     class PipelineEntry {
        public:
-        std::string m_data;
-        std::string m_from;
+        ReceiveBuffer m_data;
+        uint64_t m_from{0};
         std::chrono::system_clock::time_point m_sampleTime;
     };
 
     std::shared_ptr<cluon::NotifyingPipeline<PipelineEntry>> m_pipeline{};
+    std::shared_ptr<cluon::NotifyingPipelinePool<PipelineEntry>> m_pipelinePool{};
+    std::size_t m_queueCapacity{0};
+
+    // Entries not fitting into the full queue; only the event loop touches them unless reading is paused.
+    std::mutex m_backlogMutex{};
+    std::deque<PipelineEntry> m_backlog{};
+    std::atomic<bool> m_isPaused{false};
 };
 } // namespace cluon
 
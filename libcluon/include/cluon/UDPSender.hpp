@@ -20,10 +20,12 @@
 #endif
 // clang-format on
 
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 /**
@@ -50,6 +52,13 @@ std::pair<ssize_t, int32_t> retVal = sender.send(std::move("Hello World!"));
 std::cout << "Send " << retVal.first << " bytes, error code = " << retVal.second << std::endl;
 \endcode
 
+Several datagrams can be sent at once by supplying a `std::vector<std::string>`;
+on Linux, they are handed over to the kernel with as few `sendmmsg` calls as
+possible. If the kernel supports generic segmentation offload (`UDP_SEGMENT`),
+consecutive datagrams of equal size are passed as one buffer that is split
+into datagrams by the kernel or the network device; otherwise, or if the
+network device rejects it, the datagrams are passed one by one.
+
 A complete example is available
 [here](https://github.com/chrberger/libcluon/blob/master/libcluon/examples/cluon-UDPSender.cpp).
 */
@@ -78,17 +87,49 @@ class LIBCLUON_API UDPSender {
      */
     std::pair<ssize_t, int32_t> send(std::string &&data) const noexcept;
 
+    /**
+     * Send a given list of strings as separate datagrams in the given order.
+     * Empty strings are skipped; if any string is too large, nothing is sent.
+     *
+     * @param data Datagrams to send.
+     * @return Pair: Number of bytes sent and errno of the first failed datagram.
+     */
+    std::pair<ssize_t, int32_t> send(std::vector<std::string> &&data) const noexcept;
+
    public:
     /**
      * @return Port that this UDP sender will use for sending or 0 if no information available.
      */
     uint16_t getSendFromPort() const noexcept;
 
+    /**
+     * @return true if consecutive datagrams of equal size are handed over to the kernel as one buffer (UDP_SEGMENT).
+     */
+    bool hasSegmentationOffload() const noexcept;
+
+    /**
+     * This method enables or disables the delivery of multicast datagrams to
+     * receivers on this host (IP_MULTICAST_LOOP); it is enabled by default.
+     * Disabling it avoids that co-located processes receive and copy every
+     * datagram sent from this sender when no local receivers are expected.
+     *
+     * @param enabled true to deliver multicast datagrams to local receivers.
+     * @return true if the option could be set.
+     */
+    bool setMulticastLoopback(bool enabled) noexcept;
+
+   private:
+    /**
+     * @return Largest payload of a datagram that fits into the MTU of the path to the receiver or 0 if unknown.
+     */
+    std::size_t maxPayloadForPathMTU() const noexcept;
+
    private:
     mutable std::mutex m_socketMutex{};
     int32_t m_socket{-1};
     uint16_t m_portToSentFrom{0};
     struct sockaddr_in m_sendToAddress {};
+    mutable std::size_t m_maxSegmentSize{0};
 };
 } // namespace cluon
 
@@ -43,7 +43,6 @@ std::string EnvelopeConverter::getJSONFromProtoEncodedEnvelope(const std::string
     std::string retVal{"{}"};
     if (!m_listOfMetaMessages.empty()) {
         cluon::data::Envelope envelope;
-        std::stringstream sstr(protoEncodedEnvelope);
         constexpr uint8_t OD4_HEADER_SIZE{5};
         if (OD4_HEADER_SIZE < protoEncodedEnvelope.size()) {
             // Try decoding complete OD4-encoded Envelope including header.
@@ -53,7 +52,7 @@ std::string EnvelopeConverter::getJSONFromProtoEncodedEnvelope(const std::string
                 uint32_t length = (*reinterpret_cast<const uint32_t *>(protoEncodedEnvelope.data() + 1));
                 length          = le32toh(length) >> 8;
                 if ((OD4_HEADER_SIZE + length) == protoEncodedEnvelope.size()) {
-                    auto result{extractEnvelope(sstr)};
+                    auto result{extractEnvelope(protoEncodedEnvelope.data(), protoEncodedEnvelope.size())};
                     if (result.first) {
                         envelope = result.second;
                     }
@@ -64,7 +63,7 @@ std::string EnvelopeConverter::getJSONFromProtoEncodedEnvelope(const std::string
         if (0 == envelope.dataType()) {
             // Directly decoding complete OD4 container failed, try decoding without header.
             cluon::FromProtoVisitor protoDecoder;
-            protoDecoder.decodeFrom(sstr, envelope);
+            protoDecoder.decodeFrom(protoEncodedEnvelope.data(), protoEncodedEnvelope.size(), envelope);
         }
 
         retVal = getJSONFromEnvelope(envelope);
@@ -83,9 +82,9 @@ std::string EnvelopeConverter::getJSONFromEnvelope(cluon::data::Envelope &envelo
             ToJSONVisitor envelopeToJSON{OUTER_CURLY_BRACES, mask};
             envelope.accept(envelopeToJSON);
 
-            std::stringstream sstr{envelope.serializedData()};
+            const std::string payloadData{envelope.serializedData()};
             cluon::FromProtoVisitor protoDecoder;
-            protoDecoder.decodeFrom(sstr);
+            protoDecoder.decodeFrom(payloadData.data(), payloadData.size());
 
             // Now, create JSON from payload.
             cluon::MetaMessage payload{m_scopeOfMetaMessages[envelope.dataType()]};
@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/EnvelopeView.hpp"
+#include "cluon/FromProtoVisitor.hpp"
+#include "cluon/ProtoConstants.hpp"
+
+#include <cstring>
+
+namespace cluon {
+
+bool EnvelopeView::decodeFrom(const char *data, std::size_t length) noexcept {
+    *this = EnvelopeView();
+
+    bool retVal{nullptr != data};
+    const char *position{data};
+    const char *end{data + length};
+    uint64_t keyFieldType{0};
+    uint64_t value{0};
+    while (retVal && (position < end) && (0 < fromVarInt(position, end, keyFieldType))) {
+        const ProtoConstants PROTO_TYPE{static_cast<ProtoConstants>(keyFieldType & 0x7)};
+        const uint32_t FIELD_ID{static_cast<uint32_t>(keyFieldType >> 3)};
+        switch (PROTO_TYPE) {
+            case ProtoConstants::VARINT:
+            {
+                retVal = (0 < fromVarInt(position, end, value));
+                if (1 == FIELD_ID) {
+                    // dataType is a ZigZag-encoded int32.
+                    const uint32_t v{static_cast<uint32_t>(value)};
+                    m_dataType = static_cast<int32_t>((v >> 1) ^ -(v & 1));
+                } else if (6 == FIELD_ID) {
+                    m_senderStamp = static_cast<uint32_t>(value);
+                }
+            }
+            break;
+            case ProtoConstants::EIGHT_BYTES:
+            {
+                retVal = (8 <= (end - position));
+                position += (retVal ? 8 : 0);
+            }
+            break;
+            case ProtoConstants::FOUR_BYTES:
+            {
+                retVal = (4 <= (end - position));
+                position += (retVal ? 4 : 0);
+            }
+            break;
+            case ProtoConstants::LENGTH_DELIMITED:
+            {
+                retVal = (0 < fromVarInt(position, end, value)) && (value <= static_cast<uint64_t>(end - position));
+                if (retVal) {
+                    const std::size_t LENGTH{static_cast<std::size_t>(value)};
+                    if (2 == FIELD_ID) {
+                        m_serializedData       = position;
+                        m_serializedDataLength = LENGTH;
+                    } else if (3 == FIELD_ID) {
+                        m_sent = decodeTimeStamp(position, LENGTH);
+                    } else if (4 == FIELD_ID) {
+                        m_received = decodeTimeStamp(position, LENGTH);
+                    } else if (5 == FIELD_ID) {
+                        m_sampleTimeStamp = decodeTimeStamp(position, LENGTH);
+                    }
+                    position += LENGTH;
+                }
+            }
+            break;
+            default:
+                // Unknown wire type.
+                retVal = false;
+            break;
+        }
+    }
+    return retVal;
+}
+
+cluon::data::Envelope EnvelopeView::envelope() const noexcept {
+    cluon::data::Envelope env;
+    env.dataType(m_dataType)
+        .serializedData(std::string(m_serializedData, m_serializedDataLength))
+        .sent(m_sent)
+        .received(m_received)
+        .sampleTimeStamp(m_sampleTimeStamp)
+        .senderStamp(m_senderStamp);
+    return env;
+}
+
+int32_t EnvelopeView::dataType() const noexcept {
+    return m_dataType;
+}
+
+uint32_t EnvelopeView::senderStamp() const noexcept {
+    return m_senderStamp;
+}
+
+cluon::data::TimeStamp EnvelopeView::sent() const noexcept {
+    return m_sent;
+}
+
+cluon::data::TimeStamp EnvelopeView::received() const noexcept {
+    return m_received;
+}
+
+cluon::data::TimeStamp EnvelopeView::sampleTimeStamp() const noexcept {
+    return m_sampleTimeStamp;
+}
+
+const char *EnvelopeView::serializedData() const noexcept {
+    return m_serializedData;
+}
+
+std::size_t EnvelopeView::serializedDataLength() const noexcept {
+    return m_serializedDataLength;
+}
+
+std::size_t EnvelopeView::fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept {
+    value = 0;
+
+    constexpr uint64_t MASK  = 0x7f;
+    constexpr uint64_t SHIFT = 0x7;
+    constexpr uint64_t MSB   = 0x80;
+    constexpr std::size_t MAX_SIZE{10};
+
+    std::size_t size = 0;
+    uint64_t C{0};
+    while ((position < end) && (size < MAX_SIZE)) {
+        C = static_cast<uint64_t>(static_cast<uint8_t>(*position++));
+        value |= (C & MASK) << (SHIFT * size++);
+        if (!(C & MSB)) { // NOLINT
+            break;
+        }
+    }
+
+    return size;
+}
+
+cluon::data::TimeStamp EnvelopeView::decodeTimeStamp(const char *data, std::size_t length) noexcept {
+    cluon::data::TimeStamp ts;
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(data, length, ts);
+    return ts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::pair<bool, EnvelopeView> extractEnvelopeView(const char *data, std::size_t length) noexcept {
+    bool retVal{false};
+    EnvelopeView view;
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    if ((nullptr != data) && (OD4_HEADER_SIZE <= length)) {
+        if ((0x0D == static_cast<uint8_t>(data[0])) && (0xA4 == static_cast<uint8_t>(data[1]))) {
+            uint32_t length_{0};
+            std::memcpy(&length_, data + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+            const uint32_t LENGTH{le32toh(length_) >> 8};
+            if ((OD4_HEADER_SIZE + LENGTH) <= length) {
+                retVal = view.decodeFrom(data + OD4_HEADER_SIZE, LENGTH);
+            }
+        }
+    }
+    return std::make_pair(retVal, view);
+}
+
+std::pair<bool, EnvelopeView> extractEnvelopeView(std::istream &in, std::string &buffer) noexcept {
+    std::pair<bool, EnvelopeView> retVal{false, EnvelopeView()};
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    buffer.resize(OD4_HEADER_SIZE);
+    if (in.good() && in.read(&buffer[0], OD4_HEADER_SIZE) && (OD4_HEADER_SIZE == in.gcount())) {
+        if ((0x0D == static_cast<uint8_t>(buffer[0])) && (0xA4 == static_cast<uint8_t>(buffer[1]))) {
+            uint32_t length_{0};
+            std::memcpy(&length_, &buffer[1], sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+            const uint32_t LENGTH{le32toh(length_) >> 8};
+            buffer.resize(OD4_HEADER_SIZE + LENGTH);
+            if ((0 == LENGTH) || (in.read(&buffer[OD4_HEADER_SIZE], static_cast<std::streamsize>(LENGTH)) && (static_cast<std::streamsize>(LENGTH) == in.gcount()))) {
+                retVal = extractEnvelopeView(buffer.data(), buffer.size());
+            }
+        }
+    }
+    return retVal;
+}
+
+std::pair<bool, EnvelopeView> scanEnvelopeView(std::istream &in, std::string &buffer) noexcept {
+    uint64_t consumedBytes{0};
+    return scanEnvelopeView(in, buffer, consumedBytes);
+}
+
+std::pair<bool, EnvelopeView> scanEnvelopeView(std::istream &in, std::string &buffer, uint64_t &consumedBytes) noexcept {
+    std::pair<bool, EnvelopeView> retVal{false, EnvelopeView()};
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    // Seeking discards the stream's buffer; thus, only fields much larger than the buffer are skipped using seekg.
+    constexpr uint64_t MIN_BYTES_TO_SEEK{64 * 1024};
+    constexpr uint64_t MASK  = 0x7f;
+    constexpr uint64_t SHIFT = 0x7;
+    constexpr uint64_t MSB   = 0x80;
+    constexpr uint8_t MAX_VARINT_SIZE{10};
+    char header[OD4_HEADER_SIZE];
+    consumedBytes = 0;
+    try {
+        if (in.good() && in.read(header, OD4_HEADER_SIZE) && (OD4_HEADER_SIZE == in.gcount())) {
+            consumedBytes = OD4_HEADER_SIZE;
+            if ((0x0D == static_cast<uint8_t>(header[0])) && (0xA4 == static_cast<uint8_t>(header[1]))) {
+                uint32_t length_{0};
+                std::memcpy(&length_, header + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+                const uint64_t LENGTH{le32toh(length_) >> 8};
+
+                bool ok{true};
+                uint64_t consumed{0};
+                uint64_t keyFieldType{0};
+                uint64_t value{0};
+                if (LENGTH < MIN_BYTES_TO_SEEK) {
+                    // Read small Envelopes at once and move the fields to keep to the front of buffer.
+                    buffer.resize(static_cast<std::size_t>(LENGTH));
+                    ok = (0 == LENGTH) || (in.read(&buffer[0], static_cast<std::streamsize>(LENGTH)) && (static_cast<std::streamsize>(LENGTH) == in.gcount()));
+                    consumed = (ok ? LENGTH : static_cast<uint64_t>(in.gcount()));
+
+                    char *data{&buffer[0]};
+                    uint64_t position{0};
+                    uint64_t kept{0};
+                    // Reads a varint without exceeding the Envelope.
+                    auto readVarInt = [data, LENGTH, &position](uint64_t &v) {
+                        v = 0;
+                        for (uint8_t size{0}; (size < MAX_VARINT_SIZE) && (position < LENGTH); size++) {
+                            const uint64_t C{static_cast<uint8_t>(data[position++])};
+                            v |= (C & MASK) << (SHIFT * size);
+                            if (!(C & MSB)) { // NOLINT
+                                return true;
+                            }
+                        }
+                        return false;
+                    };
+                    while (ok && (position < LENGTH)) {
+                        const uint64_t KEY_POSITION{position};
+                        ok = readVarInt(keyFieldType);
+                        if (ok) {
+                            const ProtoConstants PROTO_TYPE{static_cast<ProtoConstants>(keyFieldType & 0x7)};
+                            const uint64_t FIELD_ID{keyFieldType >> 3};
+                            switch (PROTO_TYPE) {
+                                case ProtoConstants::VARINT:
+                                    ok = readVarInt(value);
+                                break;
+                                case ProtoConstants::EIGHT_BYTES:
+                                case ProtoConstants::FOUR_BYTES:
+                                {
+                                    const uint64_t SIZE{(ProtoConstants::EIGHT_BYTES == PROTO_TYPE) ? 8u : 4u};
+                                    ok = (SIZE <= (LENGTH - position));
+                                    position += (ok ? SIZE : 0);
+                                }
+                                break;
+                                case ProtoConstants::LENGTH_DELIMITED:
+                                    ok = readVarInt(value) && (value <= (LENGTH - position));
+                                    position += (ok ? value : 0);
+                                break;
+                                default:
+                                    ok = false;
+                                break;
+                            }
+                            // dataType (1), sampleTimeStamp (5), and senderStamp (6).
+                            if (ok && ((1 == FIELD_ID) || (5 == FIELD_ID) || (6 == FIELD_ID))) {
+                                std::memmove(data + kept, data + KEY_POSITION, static_cast<std::size_t>(position - KEY_POSITION));
+                                kept += position - KEY_POSITION;
+                            }
+                        }
+                    }
+                    buffer.resize(static_cast<std::size_t>(kept));
+                } else {
+                    // Reads a varint directly from the stream's buffer without exceeding the Envelope and optionally appends its bytes to buffer.
+                    std::streambuf *streamBuffer{in.rdbuf()};
+                    auto readVarInt = [&in, streamBuffer, &buffer, LENGTH](uint64_t &v, uint64_t &c, bool keep) {
+                        v = 0;
+                        for (uint8_t size{0}; (size < MAX_VARINT_SIZE) && (c < LENGTH); size++) {
+                            const auto C{streamBuffer->sbumpc()};
+                            if (std::istream::traits_type::eof() == C) {
+                                in.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+                                return false;
+                            }
+                            c++;
+                            if (keep) {
+                                buffer.push_back(static_cast<char>(C));
+                            }
+                            v |= (static_cast<uint64_t>(C) & MASK) << (SHIFT * size);
+                            if (!(static_cast<uint64_t>(C) & MSB)) { // NOLINT
+                                return true;
+                            }
+                        }
+                        return false;
+                    };
+                    // Advances the stream by the given number of bytes; fails if the stream ends before.
+                    auto skip = [&in](uint64_t length) {
+                        if ((MIN_BYTES_TO_SEEK <= length) && (-1 != in.tellg())) {
+                            // Seeking beyond the end succeeds; thus, read the last skipped byte to detect a truncated stream.
+                            in.seekg(static_cast<std::streamoff>(length - 1), std::ios_base::cur);
+                            return (in.good() && (std::istream::traits_type::eof() != in.get()));
+                        }
+                        in.ignore(static_cast<std::streamsize>(length));
+                        return (static_cast<std::streamsize>(length) == in.gcount());
+                    };
+
+                    buffer.clear();
+                    while (ok && (consumed < LENGTH)) {
+                        // Only the key is needed to decide whether the field is kept.
+                        const std::size_t KEY_POSITION{buffer.size()};
+                        ok = readVarInt(keyFieldType, consumed, true);
+                        if (ok) {
+                            const ProtoConstants PROTO_TYPE{static_cast<ProtoConstants>(keyFieldType & 0x7)};
+                            const uint64_t FIELD_ID{keyFieldType >> 3};
+                            // dataType (1), sampleTimeStamp (5), and senderStamp (6).
+                            const bool KEEP{(1 == FIELD_ID) || (5 == FIELD_ID) || (6 == FIELD_ID)};
+                            if (!KEEP) {
+                                buffer.resize(KEY_POSITION);
+                            }
+                            switch (PROTO_TYPE) {
+                                case ProtoConstants::VARINT:
+                                    ok = readVarInt(value, consumed, KEEP);
+                                break;
+                                case ProtoConstants::EIGHT_BYTES:
+                                case ProtoConstants::FOUR_BYTES:
+                                {
+                                    const uint64_t SIZE{(ProtoConstants::EIGHT_BYTES == PROTO_TYPE) ? 8u : 4u};
+                                    ok = (SIZE <= (LENGTH - consumed)) && skip(SIZE);
+                                    consumed += (ok ? SIZE : 0);
+                                }
+                                break;
+                                case ProtoConstants::LENGTH_DELIMITED:
+                                {
+                                    ok = readVarInt(value, consumed, KEEP) && (value <= (LENGTH - consumed));
+                                    if (ok && KEEP) {
+                                        const std::size_t POSITION{buffer.size()};
+                                        buffer.resize(POSITION + static_cast<std::size_t>(value));
+                                        ok = (0 == value)
+                                             || (in.read(&buffer[POSITION], static_cast<std::streamsize>(value)) && (static_cast<std::streamsize>(value) == in.gcount()));
+                                    } else if (ok && (0 < value)) {
+                                        ok = skip(value);
+                                    }
+                                    consumed += (ok ? value : 0);
+                                }
+                                break;
+                                default:
+                                    ok = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                consumedBytes += consumed;
+                if (ok && (consumed == LENGTH)) {
+                    retVal.first = retVal.second.decodeFrom(buffer.data(), buffer.size());
+                }
+            }
+        }
+    } catch (...) { retVal.first = false; } // LCOV_EXCL_LINE
+    return retVal;
+}
+
+} // namespace cluon
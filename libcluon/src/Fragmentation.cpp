@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/Fragmentation.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace cluon {
+
+bool isFragment(const char *data, std::size_t length) noexcept {
+    return ((nullptr != data) && (FRAGMENT_HEADER_SIZE <= length) && (FRAGMENT_HEADER_BYTE0 == static_cast<uint8_t>(data[0]))
+            && (FRAGMENT_HEADER_BYTE1 == static_cast<uint8_t>(data[1])));
+}
+
+std::vector<std::string> fragment(const std::string &data, uint32_t messageIdentifier, std::size_t maxDatagramSize) noexcept {
+    std::vector<std::string> fragments;
+    if ((FRAGMENT_HEADER_SIZE < maxDatagramSize) && (data.size() <= std::numeric_limits<uint32_t>::max())) {
+        const std::size_t PAYLOAD_SIZE{maxDatagramSize - FRAGMENT_HEADER_SIZE};
+        const std::size_t NUMBER_OF_FRAGMENTS{data.empty() ? 1 : (data.size() + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE};
+        if (NUMBER_OF_FRAGMENTS <= std::numeric_limits<uint16_t>::max()) {
+            try {
+                fragments.reserve(NUMBER_OF_FRAGMENTS);
+                for (std::size_t i{0}; i < NUMBER_OF_FRAGMENTS; i++) {
+                    const std::size_t OFFSET{i * PAYLOAD_SIZE};
+                    const std::size_t LENGTH{std::min(PAYLOAD_SIZE, data.size() - OFFSET)};
+
+                    std::string f(FRAGMENT_HEADER_SIZE + LENGTH, '\0');
+                    f[0] = static_cast<char>(FRAGMENT_HEADER_BYTE0);
+                    f[1] = static_cast<char>(FRAGMENT_HEADER_BYTE1);
+                    auto write = [&f](std::size_t position, uint64_t value, std::size_t bytes) {
+                        for (std::size_t b{0}; b < bytes; b++) {
+                            f[position + b] = static_cast<char>((value >> (8 * b)) & 0xFF);
+                        }
+                    };
+                    write(2, messageIdentifier, 4);
+                    write(6, i, 2);
+                    write(8, NUMBER_OF_FRAGMENTS, 2);
+                    write(10, data.size(), 4);
+                    write(14, OFFSET, 4);
+                    if (0 < LENGTH) {
+                        std::memcpy(&f[FRAGMENT_HEADER_SIZE], data.data() + OFFSET, LENGTH); /* Flawfinder: ignore */ // NOLINT
+                    }
+                    fragments.emplace_back(std::move(f));
+                }
+            } catch (...) { fragments.clear(); } // LCOV_EXCL_LINE
+        }
+    }
+    return fragments;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+FragmentReassembler::FragmentReassembler(std::chrono::milliseconds timeout, std::size_t maxPendingBytes) noexcept
+    : m_timeout(timeout)
+    , m_maxPendingBytes(maxPendingBytes) {}
+
+FragmentReassemblerStatistics FragmentReassembler::statistics() noexcept {
+    std::lock_guard<std::mutex> lck(m_pendingMessagesMutex);
+    return m_statistics;
+}
+
+void FragmentReassembler::drop(const MessageKey &key, bool expired) noexcept {
+    auto element = m_pendingMessages.find(key);
+    if (element != m_pendingMessages.end()) {
+        m_statistics.lostFragments += element->second.m_missingFragments;
+        m_statistics.pendingBytes -= element->second.m_data.size();
+        m_statistics.pendingMessages--;
+        if (expired) {
+            m_statistics.expiredMessages++;
+        } else {
+            m_statistics.evictedMessages++;
+        }
+        m_pendingMessages.erase(element);
+    }
+}
+
+std::pair<bool, std::string> FragmentReassembler::add(const char *data, std::size_t length, uint64_t from, std::chrono::steady_clock::time_point now) noexcept {
+    std::pair<bool, std::string> retVal{false, ""};
+    try {
+        std::lock_guard<std::mutex> lck(m_pendingMessagesMutex);
+        if (!isFragment(data, length)) {
+            m_statistics.invalidFragments++;
+            return retVal;
+        }
+        m_statistics.receivedFragments++;
+
+        auto read = [data](std::size_t position, std::size_t bytes) {
+            uint64_t value{0};
+            for (std::size_t b{0}; b < bytes; b++) {
+                value |= static_cast<uint64_t>(static_cast<uint8_t>(data[position + b])) << (8 * b);
+            }
+            return value;
+        };
+        const uint32_t MESSAGE_IDENTIFIER{static_cast<uint32_t>(read(2, 4))};
+        const uint32_t FRAGMENT_INDEX{static_cast<uint32_t>(read(6, 2))};
+        const uint32_t NUMBER_OF_FRAGMENTS{static_cast<uint32_t>(read(8, 2))};
+        const std::size_t TOTAL_LENGTH{static_cast<std::size_t>(read(10, 4))};
+        const std::size_t OFFSET{static_cast<std::size_t>(read(14, 4))};
+        const std::size_t PAYLOAD_LENGTH{length - FRAGMENT_HEADER_SIZE};
+
+        if ((FRAGMENT_INDEX >= NUMBER_OF_FRAGMENTS) || (OFFSET > TOTAL_LENGTH) || (PAYLOAD_LENGTH > TOTAL_LENGTH - OFFSET)
+            || (TOTAL_LENGTH > m_maxPendingBytes)) {
+            m_statistics.invalidFragments++;
+            return retVal;
+        }
+
+        if (1 == NUMBER_OF_FRAGMENTS) {
+            m_statistics.completedMessages++;
+            retVal.first = true;
+            retVal.second.assign(data + FRAGMENT_HEADER_SIZE, PAYLOAD_LENGTH);
+            return retVal;
+        }
+
+        // Drop incomplete messages that are too old; m_arrivalOrder might refer to messages that are already gone.
+        while (!m_arrivalOrder.empty()) {
+            auto element = m_pendingMessages.find(m_arrivalOrder.front().first);
+            if ((element != m_pendingMessages.end()) && (element->second.m_firstArrival == m_arrivalOrder.front().second)) {
+                if (now - element->second.m_firstArrival <= m_timeout) {
+                    break;
+                }
+                drop(m_arrivalOrder.front().first, true);
+            }
+            m_arrivalOrder.pop_front();
+        }
+
+        const MessageKey KEY{from, MESSAGE_IDENTIFIER};
+        auto element = m_pendingMessages.find(KEY);
+        if (element == m_pendingMessages.end()) {
+            // Make room for the new message by dropping the oldest incomplete ones.
+            while (!m_arrivalOrder.empty() && (m_statistics.pendingBytes + TOTAL_LENGTH > m_maxPendingBytes)) {
+                auto oldest = m_pendingMessages.find(m_arrivalOrder.front().first);
+                if ((oldest != m_pendingMessages.end()) && (oldest->second.m_firstArrival == m_arrivalOrder.front().second)) {
+                    drop(m_arrivalOrder.front().first, false);
+                }
+                m_arrivalOrder.pop_front();
+            }
+
+            PendingMessage pm;
+            pm.m_data.resize(TOTAL_LENGTH);
+            pm.m_receivedFragments.resize(NUMBER_OF_FRAGMENTS, false);
+            pm.m_missingFragments = NUMBER_OF_FRAGMENTS;
+            pm.m_firstArrival     = now;
+            element               = m_pendingMessages.emplace(KEY, std::move(pm)).first;
+            m_arrivalOrder.emplace_back(KEY, now);
+            m_statistics.pendingBytes += TOTAL_LENGTH;
+            m_statistics.pendingMessages++;
+        } else if ((element->second.m_data.size() != TOTAL_LENGTH) || (element->second.m_receivedFragments.size() != NUMBER_OF_FRAGMENTS)) {
+            m_statistics.invalidFragments++;
+            return retVal;
+        }
+
+        PendingMessage &pm = element->second;
+        if (pm.m_receivedFragments[FRAGMENT_INDEX]) {
+            m_statistics.duplicateFragments++;
+            return retVal;
+        }
+        if (0 < PAYLOAD_LENGTH) {
+            std::memcpy(&pm.m_data[OFFSET], data + FRAGMENT_HEADER_SIZE, PAYLOAD_LENGTH); /* Flawfinder: ignore */ // NOLINT
+        }
+        pm.m_receivedFragments[FRAGMENT_INDEX] = true;
+        pm.m_missingFragments--;
+
+        if (0 == pm.m_missingFragments) {
+            retVal.first  = true;
+            retVal.second = std::move(pm.m_data);
+            m_statistics.pendingBytes -= TOTAL_LENGTH;
+            m_statistics.pendingMessages--;
+            m_statistics.completedMessages++;
+            m_pendingMessages.erase(element);
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+} // namespace cluon
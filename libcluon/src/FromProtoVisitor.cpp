@@ -8,81 +8,143 @@
 
 #include "cluon/FromProtoVisitor.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <iterator>
 #include <utility>
 
 namespace cluon {
 
-void FromProtoVisitor::readBytesFromStream(std::istream &in, std::size_t bytesToReadFromStream, char *buffer) noexcept {
-    if (nullptr != buffer) {
-        const constexpr std::size_t CHUNK_SIZE{1024};
-        std::streamsize bufferPosition{0};
-        std::streamsize extractedBytes{0};
-
-        while ((0 < bytesToReadFromStream) && in.good()) {
-            // clang-format off
-            in.read(&buffer[static_cast<std::size_t>(bufferPosition)], /* Flawfinder: ignore */ /* Cf. buffer.reserve(...) above.  */
-                    (bytesToReadFromStream > CHUNK_SIZE) ? CHUNK_SIZE : static_cast<std::streamsize>(bytesToReadFromStream));
-            // clang-format on
-            extractedBytes = in.gcount();
-            bufferPosition += extractedBytes;
-            bytesToReadFromStream -= static_cast<std::size_t>(extractedBytes);
-        }
-    }
-}
-
-void FromProtoVisitor::decodeFrom(std::istream &in) noexcept {
-    // Reset internal states as this deserializer could be reused.
-    m_mapOfKeyValues.clear();
-    while (in.good()) {
-        // First stage: Read keyFieldType (encoded as VarInt).
-        if (0 < fromVarInt(in, m_keyFieldType)) {
-            // Succeeded to read keyFieldType entry; extract information.
-            m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
-            m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
-            switch (m_protoType) {
-                case ProtoConstants::VARINT:
-                {
-                    // Directly decode VarInt value.
-                    fromVarInt(in, m_value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_value));
-                }
-                break;
-                case ProtoConstants::EIGHT_BYTES:
-                {
-                    readBytesFromStream(in, sizeof(double), m_doubleValue.buffer.data());
+bool FromProtoVisitor::readNextField(const char *&position, const char *end) noexcept {
+    bool retVal{false};
+    // First stage: Read keyFieldType (encoded as VarInt).
+    if ((position < end) && (0 < fromVarInt(position, end, m_keyFieldType))) {
+        // Succeeded to read keyFieldType entry; extract information.
+        m_protoType = static_cast<ProtoConstants>(m_keyFieldType & 0x7);
+        m_fieldId = static_cast<uint32_t>(m_keyFieldType >> 3);
+        const std::size_t AVAILABLE_BYTES{static_cast<std::size_t>(end - position)};
+        switch (m_protoType) {
+            case ProtoConstants::VARINT:
+            {
+                // Directly decode VarInt value.
+                retVal = (0 < fromVarInt(position, end, m_value));
+            }
+            break;
+            case ProtoConstants::EIGHT_BYTES:
+            {
+                if (sizeof(double) <= AVAILABLE_BYTES) {
+                    std::memcpy(m_doubleValue.buffer.data(), position, sizeof(double)); /* Flawfinder: ignore */ // NOLINT
                     m_doubleValue.uint64Value = le64toh(m_doubleValue.uint64Value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_doubleValue.doubleValue));
+                    position += sizeof(double);
+                    retVal = true;
                 }
-                break;
-                case ProtoConstants::FOUR_BYTES:
-                {
-                    readBytesFromStream(in, sizeof(float), m_floatValue.buffer.data());
+            }
+            break;
+            case ProtoConstants::FOUR_BYTES:
+            {
+                if (sizeof(float) <= AVAILABLE_BYTES) {
+                    std::memcpy(m_floatValue.buffer.data(), position, sizeof(float)); /* Flawfinder: ignore */ // NOLINT
                     m_floatValue.uint32Value = le32toh(m_floatValue.uint32Value);
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(m_floatValue.floatValue));
+                    position += sizeof(float);
+                    retVal = true;
                 }
-                break;
-                case ProtoConstants::LENGTH_DELIMITED:
-                {
-                    fromVarInt(in, m_value);
-                    const std::size_t BYTES_TO_READ_FROM_STREAM{static_cast<std::size_t>(m_value)};
-                    if (m_stringValue.capacity() < BYTES_TO_READ_FROM_STREAM) {
-                        m_stringValue.reserve(BYTES_TO_READ_FROM_STREAM);
+            }
+            break;
+            case ProtoConstants::LENGTH_DELIMITED:
+            {
+                if (0 < fromVarInt(position, end, m_value)) {
+                    // Do not read beyond the given buffer for truncated data.
+                    const std::size_t REMAINING_BYTES{static_cast<std::size_t>(end - position)};
+                    if (m_value > REMAINING_BYTES) {
+                        m_value = REMAINING_BYTES;
                     }
-                    readBytesFromStream(in, BYTES_TO_READ_FROM_STREAM, m_stringValue.data());
-                    m_mapOfKeyValues.emplace(m_fieldId, linb::any(std::string(m_stringValue.data(), static_cast<std::size_t>(m_value))));
+                    m_stringValue = position;
+                    position += m_value;
+                    retVal = true;
                 }
-                break;
             }
+            break;
         }
     }
+    if (!retVal) {
+        // Unknown or truncated data; skip remainder.
+        position = end;
+    }
+    return retVal;
+}
+
+void FromProtoVisitor::decodeFrom(std::istream &in) noexcept {
+    // Reset internal states as this deserializer could be reused.
+    m_buffer.clear();
+    m_fields.clear();
+    if (in.good()) {
+        const std::string buffer{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        decodeFrom(buffer.data(), buffer.size());
+    }
+}
+
+void FromProtoVisitor::decodeFrom(const char *data, std::size_t length) noexcept {
+    // Reset internal states as this deserializer could be reused; the
+    // allocated memory is kept.
+    m_buffer.assign(data, length);
+    m_fields.clear();
+
+    bool isSorted{true};
+    const char *begin{m_buffer.data()};
+    const char *position{begin};
+    const char *end{begin + m_buffer.size()};
+    while (readNextField(position, end)) {
+        FieldEntry entry;
+        entry.fieldId   = m_fieldId;
+        entry.protoType = m_protoType;
+        switch (m_protoType) {
+            case ProtoConstants::VARINT:
+            {
+                entry.value = m_value;
+            }
+            break;
+            case ProtoConstants::EIGHT_BYTES:
+            {
+                entry.value = m_doubleValue.uint64Value;
+            }
+            break;
+            case ProtoConstants::FOUR_BYTES:
+            {
+                entry.value = m_floatValue.uint32Value;
+            }
+            break;
+            case ProtoConstants::LENGTH_DELIMITED:
+            {
+                entry.value  = static_cast<uint64_t>(m_stringValue - begin);
+                entry.length = static_cast<std::size_t>(m_value);
+            }
+            break;
+        }
+        isSorted = isSorted && (m_fields.empty() || (m_fields.back().fieldId <= entry.fieldId));
+        m_fields.push_back(entry);
+    }
+
+    // Fields are usually encoded in ascending order; keep the first occurrence first otherwise.
+    if (!isSorted) {
+        std::stable_sort(m_fields.begin(), m_fields.end(), [](const FieldEntry &a, const FieldEntry &b) { return a.fieldId < b.fieldId; });
+    }
+}
+
+const FromProtoVisitor::FieldEntry *FromProtoVisitor::findField(uint32_t fieldId, ProtoConstants protoType) const noexcept {
+    const FieldEntry *retVal{nullptr};
+    auto it = std::lower_bound(m_fields.begin(), m_fields.end(), fieldId, [](const FieldEntry &e, uint32_t id) { return e.fieldId < id; });
+    if ((it != m_fields.end()) && (it->fieldId == fieldId) && (it->protoType == protoType)) {
+        retVal = &(*it);
+    }
+    return retVal;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 FromProtoVisitor &FromProtoVisitor::operator=(const FromProtoVisitor &other) noexcept {
-    m_mapOfKeyValues = other.m_mapOfKeyValues;
+    m_buffer = other.m_buffer;
+    m_fields = other.m_fields;
     return *this;
 }
 
@@ -102,10 +164,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = (0 != m_value);
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            v = (0 != linb::any_cast<uint64_t>(m_mapOfKeyValues[id]));
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = (0 != entry->value);
         }
     }
 }
@@ -116,11 +178,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<char>(m_value);
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<char>(_v);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<char>(entry->value);
         }
     }
 }
@@ -131,11 +192,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<int8_t>(fromZigZag8(static_cast<uint8_t>(m_value)));
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<int8_t>(fromZigZag8(static_cast<uint8_t>(_v)));
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<int8_t>(fromZigZag8(static_cast<uint8_t>(entry->value)));
         }
     }
 }
@@ -146,11 +206,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<uint8_t>(m_value);
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<uint8_t>(_v);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<uint8_t>(entry->value);
         }
     }
 }
@@ -161,11 +220,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<int16_t>(fromZigZag16(static_cast<uint16_t>(m_value)));
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<int16_t>(fromZigZag16(static_cast<uint16_t>(_v)));
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<int16_t>(fromZigZag16(static_cast<uint16_t>(entry->value)));
         }
     }
 }
@@ -176,11 +234,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<uint16_t>(m_value);
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<uint16_t>(_v);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<uint16_t>(entry->value);
         }
     }
 }
@@ -191,11 +248,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<int32_t>(fromZigZag32(static_cast<uint32_t>(m_value)));
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<int32_t>(fromZigZag32(static_cast<uint32_t>(_v)));
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<int32_t>(fromZigZag32(static_cast<uint32_t>(entry->value)));
         }
     }
 }
@@ -206,11 +262,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<uint32_t>(m_value);
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<uint32_t>(_v);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<uint32_t>(entry->value);
         }
     }
 }
@@ -221,11 +276,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = static_cast<int64_t>(fromZigZag64(static_cast<uint64_t>(m_value)));
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            uint64_t _v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-            v           = static_cast<int64_t>(fromZigZag64(_v));
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = static_cast<int64_t>(fromZigZag64(entry->value));
         }
     }
 }
@@ -236,10 +290,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = m_value;
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            v = linb::any_cast<uint64_t>(m_mapOfKeyValues[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::VARINT)};
+        if (nullptr != entry) {
+            v = entry->value;
         }
     }
 }
@@ -250,10 +304,11 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = m_floatValue.floatValue;
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            v = linb::any_cast<float>(m_mapOfKeyValues[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::FOUR_BYTES)};
+        if (nullptr != entry) {
+            const uint32_t _v{static_cast<uint32_t>(entry->value)};
+            std::memcpy(&v, &_v, sizeof(float)); /* Flawfinder: ignore */ // NOLINT
         }
     }
 }
@@ -264,10 +319,10 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     if (m_callToDecodeFromWithDirectVisit) {
         v = m_doubleValue.doubleValue;
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            v = linb::any_cast<double>(m_mapOfKeyValues[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::EIGHT_BYTES)};
+        if (nullptr != entry) {
+            std::memcpy(&v, &entry->value, sizeof(double)); /* Flawfinder: ignore */ // NOLINT
         }
     }
 }
@@ -276,12 +331,12 @@ void FromProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&
     (void)typeName;
     (void)name;
     if (m_callToDecodeFromWithDirectVisit) {
-        v = std::string(m_stringValue.data(), static_cast<std::size_t>(m_value));
+        v.assign(m_stringValue, static_cast<std::size_t>(m_value));
     }
-    else if (m_mapOfKeyValues.count(id) > 0) {
-        try {
-            v = linb::any_cast<std::string>(m_mapOfKeyValues[id]);
-        } catch (const linb::bad_any_cast &) { // LCOV_EXCL_LINE
+    else {
+        const FieldEntry *entry{findField(id, ProtoConstants::LENGTH_DELIMITED)};
+        if (nullptr != entry) {
+            v.assign(m_buffer.data() + static_cast<std::size_t>(entry->value), entry->length);
         }
     }
 }
@@ -304,18 +359,19 @@ int64_t FromProtoVisitor::fromZigZag64(uint64_t v) noexcept {
     return static_cast<int64_t>((v >> 1) ^ -(v & 1));
 }
 
-std::size_t FromProtoVisitor::fromVarInt(std::istream &in, uint64_t &value) noexcept {
+std::size_t FromProtoVisitor::fromVarInt(const char *&position, const char *end, uint64_t &value) noexcept {
     value = 0;
 
     constexpr uint64_t MASK  = 0x7f;
     constexpr uint64_t SHIFT = 0x7;
     constexpr uint64_t MSB   = 0x80;
+    // A 64-bit value is encoded in at most 10 bytes.
+    constexpr std::size_t MAX_SIZE{10};
 
     std::size_t size = 0;
     uint64_t C{0};
-    while (in.good()) {
-        auto x = in.get();
-        C = static_cast<uint64_t>(x);
+    while ((position < end) && (size < MAX_SIZE)) {
+        C = static_cast<uint64_t>(static_cast<uint8_t>(*position++));
         value |= (C & MASK) << (SHIFT * size++);
         if (!(C & MSB)) { // NOLINT
             break;
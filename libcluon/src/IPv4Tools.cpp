@@ -78,4 +78,18 @@ std::string getIPv4FromHostname(const std::string &hostname) noexcept {
     return result;
 }
 
+uint64_t encodeSenderAddress(uint32_t address, uint16_t port) noexcept {
+    return (static_cast<uint64_t>(ntohl(address)) << 16) | port;
+}
+
+std::string decodeSenderAddress(uint64_t sender) noexcept {
+    std::string retVal;
+    try {
+        const uint32_t ADDRESS{static_cast<uint32_t>(sender >> 16)};
+        retVal = std::to_string((ADDRESS >> 24) & 0xFF) + '.' + std::to_string((ADDRESS >> 16) & 0xFF) + '.' + std::to_string((ADDRESS >> 8) & 0xFF) + '.'
+                 + std::to_string(ADDRESS & 0xFF) + ':' + std::to_string(sender & 0xFFFF);
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
 } // namespace cluon
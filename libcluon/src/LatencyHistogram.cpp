@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace cluon {
+
+LatencyHistogram::LatencyHistogram(bool enabled) noexcept
+    : m_enabled{enabled}
+    , m_minInNanoseconds{std::numeric_limits<uint64_t>::max()} {
+    for (auto &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::setEnabled(bool enabled) noexcept {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyHistogram::isEnabled() const noexcept {
+    return m_enabled.load(std::memory_order_relaxed);
+}
+
+std::size_t LatencyHistogram::bucketOf(uint64_t latencyInNanoseconds) noexcept {
+    if (latencyInNanoseconds < SUB_BUCKETS) {
+        return static_cast<std::size_t>(latencyInNanoseconds);
+    }
+    // Find the most significant bit; the two bits below it select the sub-bucket.
+    uint32_t msb{0};
+    for (uint32_t shift{32}; shift > 0; shift >>= 1) {
+        if (0 != (latencyInNanoseconds >> (msb + shift))) {
+            msb += shift;
+        }
+    }
+    return static_cast<std::size_t>((msb - 1) * SUB_BUCKETS + ((latencyInNanoseconds >> (msb - 2)) & (SUB_BUCKETS - 1)));
+}
+
+uint64_t LatencyHistogram::upperBoundOf(std::size_t bucket) noexcept {
+    if (bucket < SUB_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    const uint32_t MSB{static_cast<uint32_t>(bucket / SUB_BUCKETS) + 1};
+    const uint64_t LOWER_BOUND{static_cast<uint64_t>(SUB_BUCKETS + (bucket % SUB_BUCKETS)) << (MSB - 2)};
+    return LOWER_BOUND + ((static_cast<uint64_t>(1) << (MSB - 2)) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) noexcept {
+    if (!m_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    uint64_t value{0};
+    if (latency.count() < 0) {
+        m_negativeSamples.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        value = static_cast<uint64_t>(latency.count());
+    }
+    m_buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    m_sumInNanoseconds.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current{m_minInNanoseconds.load(std::memory_order_relaxed)};
+    while ((value < current) && !m_minInNanoseconds.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    current = m_maxInNanoseconds.load(std::memory_order_relaxed);
+    while ((value > current) && !m_maxInNanoseconds.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+
+    m_samples.fetch_add(1, std::memory_order_release);
+}
+
+void LatencyHistogram::reset() noexcept {
+    for (auto &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_negativeSamples.store(0, std::memory_order_relaxed);
+    m_sumInNanoseconds.store(0, std::memory_order_relaxed);
+    m_minInNanoseconds.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_maxInNanoseconds.store(0, std::memory_order_relaxed);
+    m_samples.store(0, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const noexcept {
+    std::array<uint64_t, NUMBER_OF_BUCKETS> counts{};
+    uint64_t samples{0};
+    for (std::size_t i{0}; i < NUMBER_OF_BUCKETS; i++) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        samples += counts[i];
+    }
+    if (0 == samples) {
+        return 0;
+    }
+
+    // Rank of the sample at the given percentile, starting at 1.
+    const double CLAMPED{std::min(100.0, std::max(0.0, percentile))};
+    const uint64_t RANK{std::max<uint64_t>(1, static_cast<uint64_t>(CLAMPED / 100.0 * static_cast<double>(samples) + 0.5))};
+    uint64_t seen{0};
+    for (std::size_t i{0}; i < NUMBER_OF_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= RANK) {
+            return std::min(upperBoundOf(i), m_maxInNanoseconds.load(std::memory_order_relaxed));
+        }
+    }
+    return m_maxInNanoseconds.load(std::memory_order_relaxed); // LCOV_EXCL_LINE
+}
+
+LatencyHistogramStatistics LatencyHistogram::statistics() const noexcept {
+    LatencyHistogramStatistics stats;
+    stats.samples = m_samples.load(std::memory_order_acquire);
+    if (0 < stats.samples) {
+        stats.negativeSamples                   = m_negativeSamples.load(std::memory_order_relaxed);
+        stats.minLatencyInNanoseconds           = m_minInNanoseconds.load(std::memory_order_relaxed);
+        stats.maxLatencyInNanoseconds           = m_maxInNanoseconds.load(std::memory_order_relaxed);
+        stats.meanLatencyInNanoseconds          = m_sumInNanoseconds.load(std::memory_order_relaxed) / stats.samples;
+        stats.medianLatencyInNanoseconds        = percentile(50.0);
+        stats.percentile90LatencyInNanoseconds  = percentile(90.0);
+        stats.percentile99LatencyInNanoseconds  = percentile(99.0);
+        stats.percentile999LatencyInNanoseconds = percentile(99.9);
+    }
+    return stats;
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> LatencyHistogram::buckets() const noexcept {
+    std::vector<std::pair<uint64_t, uint64_t>> retVal;
+    try {
+        for (std::size_t i{0}; i < NUMBER_OF_BUCKETS; i++) {
+            const uint64_t COUNT{m_buckets[i].load(std::memory_order_relaxed)};
+            if (0 < COUNT) {
+                retVal.emplace_back(upperBoundOf(i), COUNT);
+            }
+        }
+    } catch (...) { retVal.clear(); } // LCOV_EXCL_LINE
+    return retVal;
+}
+} // namespace cluon
@@ -8,29 +8,83 @@
 
 #include "cluon/OD4Session.hpp"
 #include "cluon/Envelope.hpp"
+#include "cluon/EnvelopeView.hpp"
 #include "cluon/FromProtoVisitor.hpp"
 #include "cluon/TerminateHandler.hpp"
 #include "cluon/Time.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <thread>
 
 namespace cluon {
 
-OD4Session::OD4Session(uint16_t CID, std::function<void(cluon::data::Envelope &&envelope)> delegate) noexcept
-    : m_receiver{nullptr}
+OD4Session::OD4Session(uint16_t CID, std::function<void(cluon::data::Envelope &&envelope)> delegate, std::size_t numberOfWorkers, std::size_t numberOfReceivers) noexcept
+    : m_receivers{}
     , m_sender{"225.0.0." + std::to_string(CID), 12175}
     , m_delegate(std::move(delegate))
+    , m_numberOfWorkers((0 < numberOfWorkers) ? numberOfWorkers : 1)
     , m_mapOfDataTriggeredDelegatesMutex{}
     , m_mapOfDataTriggeredDelegates{} {
-    m_receiver = std::make_unique<cluon::UDPReceiver>(
-        "225.0.0." + std::to_string(CID),
-        12175,
-        [this](std::string &&data, std::string &&from, std::chrono::system_clock::time_point &&timepoint) {
-            this->callback(std::move(data), std::move(from), std::move(timepoint));
-        },
-        m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */);
+    const std::size_t NUMBER_OF_RECEIVERS{(0 < numberOfReceivers) ? numberOfReceivers : 1};
+    if (1 < m_numberOfWorkers) {
+        // Preserve the order per (dataType, senderStamp) using the meta data decoded by the receiving thread.
+        auto orderingKey = [](const DecodedEnvelope &entry) {
+            return static_cast<std::size_t>((static_cast<uint64_t>(static_cast<uint32_t>(entry.m_view.dataType())) << 32) | entry.m_view.senderStamp());
+        };
+        auto dispatchEntry = [this](DecodedEnvelope &&entry) { this->dispatch(entry.m_view, entry.m_receivedTimePoint); };
+        try {
+            for (std::size_t i{0}; i < NUMBER_OF_RECEIVERS; i++) {
+                m_workerPools.emplace_back(std::make_unique<cluon::NotifyingPipelinePool<DecodedEnvelope>>(
+                    m_numberOfWorkers, orderingKey, dispatchEntry, RECEIVE_QUEUE_CAPACITY, cluon::FullQueuePolicy::BLOCK));
+            }
+        } catch (...) { m_workerPools.clear(); } // LCOV_EXCL_LINE
+    }
+
+#ifdef __linux__
+    // Each socket gets its shard's filter before it is bound; thus, no Envelope is lost or received twice.
+    m_receiversAreSharded.store(1 < NUMBER_OF_RECEIVERS);
+#endif
+    for (std::size_t i{0}; i < NUMBER_OF_RECEIVERS; i++) {
+        std::vector<SocketFilterInstruction> program;
+        if (m_receiversAreSharded.load()) {
+            program = createEnvelopeShardFilter(static_cast<uint32_t>(i), static_cast<uint32_t>(NUMBER_OF_RECEIVERS), {}, false);
+        }
+        m_receivers.emplace_back(std::make_unique<cluon::UDPReceiver>(
+            "225.0.0." + std::to_string(CID),
+            12175,
+            [this, i](ReceiveBuffer &&data, uint64_t from, std::chrono::system_clock::time_point &&timepoint) {
+                // Until all receivers have their shard's filter, the first one receives everything.
+                if ((0 == i) || this->m_receiversAreSharded.load()) {
+                    this->callback(i, std::move(data), from, std::move(timepoint));
+                }
+            },
+            m_sender.getSendFromPort() /* passing our local send from port to the UDPReceiver to filter out our own bytes */,
+            1,
+            nullptr,
+            RECEIVE_QUEUE_CAPACITY,
+            program));
+    }
+    if (1 < NUMBER_OF_RECEIVERS) {
+        // Falls back to the first receiver passing on all Envelopes if a filter could not be attached.
+        updateKernelDataTypeFilter();
+    }
+}
+
+OD4Session::~OD4Session() noexcept {
+    // Stop receiving before the workers and the dispatch lanes are stopped.
+    m_receivers.clear();
+    m_workerPools.clear();
+    try {
+        std::vector<std::unique_ptr<cluon::NotifyingPipeline<LaneEntry>>> lanes;
+        {
+            std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+            lanes.swap(m_lanes);
+        }
+        lanes.clear();
+    } catch (...) {} // LCOV_EXCL_LINE
 }
 
 void OD4Session::timeTrigger(float freq, std::function<bool()> delegate) noexcept {
@@ -39,11 +93,18 @@ void OD4Session::timeTrigger(float freq, std::function<bool()> delegate) noexcep
         const int64_t TIME_SLICE_IN_MILLISECONDS{static_cast<uint32_t>(1000 / ((freq > 0) ? freq : 1.0f))};
         do {
             cluon::data::TimeStamp before{cluon::time::now()};
+            const bool BATCH{m_batchTimeTrigger.load()};
+            if (BATCH) {
+                beginBatch();
+            }
             try {
                 delegateIsRunning = delegate();
             } catch (...) {
                 delegateIsRunning = false; // delegate threw exception.
             }
+            if (BATCH) {
+                flush();
+            }
             cluon::data::TimeStamp after{cluon::time::now()};
 
             const int64_t beforeInMicroseconds{cluon::time::toMicroseconds(before)};
@@ -77,11 +138,129 @@ bool OD4Session::dataTrigger(int32_t messageIdentifier, std::function<void(cluon
             }
             retVal = true;
         } catch (...) {} // LCOV_EXCL_LINE
+        if (retVal && m_kernelDataTypeFilter.load()) {
+            updateKernelDataTypeFilter();
+        }
     }
     return retVal;
 }
 
-void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chrono::system_clock::time_point &&timepoint) noexcept {
+bool OD4Session::dispatchLane(const std::vector<int32_t> &dataTypes, int32_t realtimePriority, int32_t cpu) noexcept {
+    bool retVal{false};
+    if (nullptr == m_delegate) {
+        try {
+            auto delegate = [this](LaneEntry &&entry) { this->dispatchInLane(std::move(entry)); };
+            auto lane     = std::make_unique<cluon::NotifyingPipeline<LaneEntry>>(delegate);
+            lane->setHighWaterMark(LANE_CAPACITY);
+            if (lane->setScheduling(realtimePriority, cpu)) {
+                std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+                bool isAssigned{false};
+                for (const int32_t dataType : dataTypes) {
+                    isAssigned |= (m_laneOfDataType.end() != m_laneOfDataType.find(dataType));
+                }
+                if (!isAssigned) {
+                    if (m_lanes.empty()) {
+                        m_lanes.emplace_back(std::make_unique<cluon::NotifyingPipeline<LaneEntry>>(delegate));
+                        m_lanes.back()->setHighWaterMark(LANE_CAPACITY);
+                    }
+                    for (const int32_t dataType : dataTypes) {
+                        m_laneOfDataType[dataType] = m_lanes.size();
+                    }
+                    m_lanes.emplace_back(std::move(lane));
+                    retVal = true;
+                }
+            }
+        } catch (...) { retVal = false; } // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
+
+std::vector<NotifyingPipelineStatistics> OD4Session::laneStatistics() noexcept {
+    std::vector<NotifyingPipelineStatistics> retVal;
+    try {
+        std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+        for (const auto &lane : m_lanes) {
+            retVal.push_back(lane->statistics());
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+void OD4Session::dispatchInLane(LaneEntry &&entry) noexcept {
+    try {
+        std::function<void(cluon::data::Envelope && envelope)> delegate{nullptr};
+        {
+            std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+            auto element = m_mapOfDataTriggeredDelegates.find(entry.m_envelope.dataType());
+            if (element != m_mapOfDataTriggeredDelegates.end()) {
+                delegate = element->second;
+            }
+        }
+        if (nullptr != delegate) {
+            if (m_deliveryLatency.isEnabled()) {
+                m_deliveryLatency.record(std::chrono::system_clock::now() - entry.m_receivedTimePoint);
+            }
+            delegate(std::move(entry.m_envelope));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+bool OD4Session::kernelDataTypeFilter(bool enabled) noexcept {
+    if (nullptr != m_delegate) {
+        return false;
+    }
+    m_kernelDataTypeFilter.store(enabled);
+    return updateKernelDataTypeFilter();
+}
+
+bool OD4Session::updateKernelDataTypeFilter() noexcept {
+    bool retVal{true};
+    try {
+        // Serialize regenerating and attaching the filters with changes to the data triggers.
+        std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+        const bool FILTER_DATATYPES{m_kernelDataTypeFilter.load()};
+        std::vector<int32_t> dataTypes;
+        if (FILTER_DATATYPES) {
+            for (const auto &e : m_mapOfDataTriggeredDelegates) {
+                if (nullptr != e.second) {
+                    dataTypes.push_back(e.first);
+                }
+            }
+        }
+
+        // An empty program, e.g., for too many data triggers, lets all Envelopes pass.
+        const uint32_t NUMBER_OF_SHARDS{static_cast<uint32_t>(m_receivers.size())};
+        for (uint32_t i{0}; i < NUMBER_OF_SHARDS; i++) {
+            std::vector<SocketFilterInstruction> program;
+            if ((1 < NUMBER_OF_SHARDS) || FILTER_DATATYPES) {
+                program = createEnvelopeShardFilter(i, NUMBER_OF_SHARDS, dataTypes, FILTER_DATATYPES);
+            }
+            retVal &= ((1 < NUMBER_OF_SHARDS) && program.empty()) ? false : m_receivers[i]->setSocketFilter(program);
+        }
+
+        if (1 < NUMBER_OF_SHARDS) {
+            m_receiversAreSharded.store(retVal);
+            if (!retVal) {
+                // Without socket filters, the first receiver passes all Envelopes on.
+                m_receivers[0]->setSocketFilter({});
+            }
+        }
+    } catch (...) { retVal = false; } // LCOV_EXCL_LINE
+    return retVal;
+}
+
+void OD4Session::callback(std::size_t receiver, ReceiveBuffer &&data, uint64_t from, std::chrono::system_clock::time_point &&timepoint) noexcept {
+    std::unique_ptr<std::string> reassembled{nullptr};
+    if (isFragment(data.data(), data.size())) {
+        auto retVal = m_fragmentReassembler.add(data.data(), data.size(), from, std::chrono::steady_clock::now());
+        if (!retVal.first) {
+            return;
+        }
+        try {
+            reassembled = std::make_unique<std::string>(std::move(retVal.second));
+        } catch (...) { return; } // LCOV_EXCL_LINE
+    }
+
     size_t numberOfDataTriggeredDelegates{0};
     {
         try {
@@ -91,39 +270,194 @@ void OD4Session::callback(std::string &&data, std::string && /*from*/, std::chro
     }
     // Only unpack the envelope when it needs to be post-processed.
     if ((nullptr != m_delegate) || (0 < numberOfDataTriggeredDelegates)) {
-        std::stringstream sstr(data);
-        auto retVal = extractEnvelope(sstr);
-
+        // Decode only the Envelope's meta data; the payload is copied only for delegates that consume it.
+        auto retVal = (nullptr != reassembled) ? extractEnvelopeView(reassembled->data(), reassembled->size()) : extractEnvelopeView(data.data(), data.size());
         if (retVal.first) {
-            cluon::data::Envelope env{retVal.second};
-            env.received(cluon::time::convert(timepoint));
-
-            // "Catch all"-delegate.
-            if (nullptr != m_delegate) {
-                m_delegate(std::move(env));
+            if (m_workerPools.empty()) {
+                dispatch(retVal.second, timepoint);
             } else {
-                try {
-                    // Data triggered-delegates.
-                    std::lock_guard<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
-                    if (m_mapOfDataTriggeredDelegates.count(env.dataType()) > 0) {
-                        m_mapOfDataTriggeredDelegates[env.dataType()](std::move(env));
-                    }
-                } catch (...) {} // LCOV_EXCL_LINE
+                // The view stays valid as the slab and the reassembled bytes do not move with the entry.
+                DecodedEnvelope entry;
+                entry.m_data              = std::move(data);
+                entry.m_reassembled       = std::move(reassembled);
+                entry.m_view              = retVal.second;
+                entry.m_receivedTimePoint = timepoint;
+                m_workerPools[receiver]->add(std::move(entry));
+                m_workerPools[receiver]->notifyAll();
             }
         }
     }
 }
 
+void OD4Session::dispatch(const EnvelopeView &view, const std::chrono::system_clock::time_point &timepoint) noexcept {
+    if (m_transportLatency.isEnabled()) {
+        const int64_t SENT{cluon::time::toMicroseconds(view.sent())};
+        if (0 < SENT) {
+            m_transportLatency.record(timepoint.time_since_epoch() - std::chrono::microseconds(SENT));
+        }
+    }
+
+    // "Catch all"-delegate.
+    if (nullptr != m_delegate) {
+        cluon::data::Envelope env{view.envelope()};
+        env.received(cluon::time::convert(timepoint));
+        if (m_deliveryLatency.isEnabled()) {
+            m_deliveryLatency.record(std::chrono::system_clock::now() - timepoint);
+        }
+        m_delegate(std::move(env));
+    } else {
+        try {
+            // Data triggered-delegates.
+            std::unique_lock<std::mutex> lck{m_mapOfDataTriggeredDelegatesMutex};
+            auto element = m_mapOfDataTriggeredDelegates.find(view.dataType());
+            if (element != m_mapOfDataTriggeredDelegates.end()) {
+                cluon::data::Envelope env{view.envelope()};
+                env.received(cluon::time::convert(timepoint));
+                if (!m_lanes.empty()) {
+                    // Hand the Envelope to its lane; lanes are never removed while receiving.
+                    auto lane = m_laneOfDataType.find(view.dataType());
+                    cluon::NotifyingPipeline<LaneEntry> *pipeline{m_lanes[(lane != m_laneOfDataType.end()) ? lane->second : 0].get()};
+                    lck.unlock();
+
+                    LaneEntry entry;
+                    entry.m_envelope          = std::move(env);
+                    entry.m_receivedTimePoint = timepoint;
+                    pipeline->add(std::move(entry));
+                    pipeline->notifyAll();
+                    return;
+                }
+                if (m_deliveryLatency.isEnabled()) {
+                    m_deliveryLatency.record(std::chrono::system_clock::now() - timepoint);
+                }
+                if ((1 < m_numberOfWorkers) || (1 < m_receivers.size())) {
+                    // Do not serialize the workers on the mutex while the delegate is running.
+                    auto delegate = element->second;
+                    lck.unlock();
+                    delegate(std::move(env));
+                } else {
+                    element->second(std::move(env));
+                }
+            }
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+}
+
 void OD4Session::send(cluon::data::Envelope &&envelope) noexcept {
     sendInternal(cluon::serializeEnvelope(std::move(envelope)));
 }
 
+void OD4Session::send(std::vector<cluon::data::Envelope> &&envelopes) noexcept {
+    try {
+        std::vector<std::string> datagrams;
+        datagrams.reserve(envelopes.size());
+        for (auto &envelope : envelopes) {
+            appendDatagrams(cluon::serializeEnvelope(std::move(envelope)), datagrams);
+        }
+        envelopes.clear();
+        sendDatagrams(std::move(datagrams));
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+void OD4Session::beginBatch() noexcept {
+    std::lock_guard<std::mutex> lck(m_batchMutex);
+    m_isBatching = true;
+}
+
+void OD4Session::flush() noexcept {
+    std::vector<std::string> datagrams;
+    {
+        std::lock_guard<std::mutex> lck(m_batchMutex);
+        m_isBatching = false;
+        datagrams.swap(m_batch);
+    }
+    if (!datagrams.empty()) {
+        m_sender.send(std::move(datagrams));
+    }
+}
+
+void OD4Session::batchTimeTrigger(bool enabled) noexcept {
+    m_batchTimeTrigger.store(enabled);
+}
+
+void OD4Session::fragmentLargeEnvelopes(bool enabled) noexcept {
+    m_fragmentLargeEnvelopes.store(enabled);
+}
+
+FragmentReassemblerStatistics OD4Session::fragmentStatistics() noexcept {
+    return m_fragmentReassembler.statistics();
+}
+
+bool OD4Session::multicastLoopback(bool enabled) noexcept {
+    return m_sender.setMulticastLoopback(enabled);
+}
+
+bool OD4Session::timeStampMode(ReceiveTimeStampMode mode) noexcept {
+    bool retVal{!m_receivers.empty()};
+    for (const auto &receiver : m_receivers) {
+        retVal &= receiver->setTimeStampMode(mode);
+    }
+    return retVal;
+}
+
+LatencyHistogram &OD4Session::deliveryLatency() noexcept {
+    return m_deliveryLatency;
+}
+
+LatencyHistogram &OD4Session::transportLatency() noexcept {
+    return m_transportLatency;
+}
+
 void OD4Session::sendInternal(std::string &&dataToSend) noexcept {
+    try {
+        if (MAX_DATAGRAM_LENGTH < dataToSend.size()) {
+            std::vector<std::string> datagrams;
+            appendDatagrams(std::move(dataToSend), datagrams);
+            sendDatagrams(std::move(datagrams));
+            return;
+        }
+
+        std::lock_guard<std::mutex> lck(m_batchMutex);
+        if (m_isBatching) {
+            m_batch.emplace_back(std::move(dataToSend));
+            return;
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
     m_sender.send(std::move(dataToSend));
 }
 
+void OD4Session::appendDatagrams(std::string &&dataToSend, std::vector<std::string> &datagrams) noexcept {
+    try {
+        if (MAX_DATAGRAM_LENGTH >= dataToSend.size()) {
+            datagrams.emplace_back(std::move(dataToSend));
+        } else if (m_fragmentLargeEnvelopes.load()) {
+            auto fragments = fragment(dataToSend, m_nextFragmentedMessageIdentifier++, MAX_DATAGRAM_LENGTH);
+            std::move(fragments.begin(), fragments.end(), std::back_inserter(datagrams));
+        }
+        // Without fragmentation, Envelopes too large for one datagram are skipped.
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+void OD4Session::sendDatagrams(std::vector<std::string> &&datagrams) noexcept {
+    try {
+        {
+            std::lock_guard<std::mutex> lck(m_batchMutex);
+            if (m_isBatching) {
+                std::move(datagrams.begin(), datagrams.end(), std::back_inserter(m_batch));
+                return;
+            }
+        }
+        if (!datagrams.empty()) {
+            m_sender.send(std::move(datagrams));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
 bool OD4Session::isRunning() noexcept {
-    return m_receiver->isRunning();
+    bool retVal{!m_receivers.empty()};
+    for (const auto &receiver : m_receivers) {
+        retVal &= receiver->isRunning();
+    }
+    return retVal;
 }
 
 } // namespace cluon
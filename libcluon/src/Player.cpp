@@ -8,42 +8,65 @@
 
 #include "cluon/Player.hpp"
 #include "cluon/Envelope.hpp"
+#include "cluon/EnvelopeView.hpp"
 #include "cluon/Time.hpp"
 
+// clang-format off
+#ifdef WIN32
+    #include <process.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <sys/types.h>
+// clang-format on
+
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <iostream>
-#include <limits>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace cluon {
 
-IndexEntry::IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition) noexcept
+IndexEntry::IndexEntry(const int64_t &sampleTimeStamp, const uint64_t &filePosition, const int32_t &dataType, const uint32_t &senderStamp) noexcept
     : m_sampleTimeStamp(sampleTimeStamp)
     , m_filePosition(filePosition)
+    , m_dataType(dataType)
+    , m_senderStamp(senderStamp)
     , m_available(false) {}
 
 ////////////////////////////////////////////////////////////////////////
 
-Player::Player(const std::string &file, const bool &autoRewind, const bool &threading) noexcept
+Player::Player(const std::string &file, const bool &autoRewind, const bool &threading, const bool &memoryMapped) noexcept
     : m_threading(threading)
     , m_file(file)
     , m_recFile()
     , m_recFileValid(false)
+    , m_memoryMapped(memoryMapped)
+    , m_mapping(nullptr)
+    , m_mappingSize(0)
+    , m_envelopeViewBuffer()
     , m_autoRewind(autoRewind)
     , m_indexMutex()
     , m_index()
-    , m_previousPreviousEnvelopeAlreadyReplayed(m_index.end())
-    , m_previousEnvelopeAlreadyReplayed(m_index.begin())
-    , m_currentEnvelopeToReplay(m_index.begin())
-    , m_nextEntryToReadFromRecFile(m_index.begin())
+    , m_previousPreviousEnvelopeAlreadyReplayed(0)
+    , m_previousEnvelopeAlreadyReplayed(0)
+    , m_currentEnvelopeToReplay(0)
+    , m_nextEntryToReadFromRecFile(0)
     , m_desiredInitialLevel(0)
     , m_firstTimePointReturningAEnvelope()
     , m_numberOfReturnedEnvelopesInTotal(0)
+    , m_numberOfSkippedEntries(0)
     , m_delay(0)
     , m_envelopeCacheFillingThreadIsRunningMutex()
     , m_envelopeCacheFillingThreadIsRunning(false)
@@ -52,6 +75,8 @@ Player::Player(const std::string &file, const bool &autoRewind, const bool &thre
     , m_playerListenerMutex()
     , m_playerListener(nullptr) {
     initializeIndex();
+    // Threading is only needed when falling back to reading from file.
+    m_threading = m_threading && !m_memoryMapped;
     computeInitialCacheLevelAndFillCache();
 
     if (m_threading) {
@@ -69,6 +94,8 @@ Player::~Player() {
     }
 
     m_recFile.close();
+
+    releaseMemoryMapping();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -81,34 +108,67 @@ void Player::setPlayerListener(std::function<void(cluon::data::PlayerStatus play
 ////////////////////////////////////////////////////////////////////////
 
 void Player::initializeIndex() noexcept {
-    m_recFile.open(m_file.c_str(), std::ios_base::in | std::ios_base::binary); /* Flawfinder: ignore */
-    m_recFileValid = m_recFile.good();
+    if (m_memoryMapped) {
+        m_memoryMapped = initializeMemoryMapping();
+        if (!m_memoryMapped) {
+            std::cerr << "[cluon::Player]: " << m_file << " could not be memory-mapped; falling back to reading from file." << std::endl;
+        }
+    }
+    if (!m_memoryMapped) {
+        m_recFile.open(m_file.c_str(), std::ios_base::in | std::ios_base::binary); /* Flawfinder: ignore */
+        m_recFileValid = m_recFile.good();
+    }
 
     if (m_recFileValid) {
-        // Determine file size to display progress.
-        m_recFile.seekg(0, m_recFile.end);
-        int64_t fileLength = m_recFile.tellg();
-        m_recFile.seekg(0, m_recFile.beg);
+        const cluon::data::TimeStamp BEFORE{cluon::time::now()};
+        if (loadIndexFile()) {
+            const cluon::data::TimeStamp AFTER{cluon::time::now()};
+            std::cerr << "[cluon::Player]: " << m_file << " contains " << m_index.size() << " entries; "
+                      << "loaded index from " << m_file << ".idx in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000) << "ms."
+                      << std::endl;
+            return;
+        }
 
-        // Read complete file and store file positions to envelopes to create
-        // index of available data. The actual reading of Envelopes is deferred.
         uint64_t totalBytesRead = 0;
-        const cluon::data::TimeStamp BEFORE{cluon::time::now()};
-        {
+        uint64_t recFileSize{0};
+        int64_t recFileModificationTime{0};
+        if (m_memoryMapped) {
+            totalBytesRead = indexMemoryMapping();
+        } else if ((1 < std::thread::hardware_concurrency()) && getRecFileState(m_file, recFileSize, recFileModificationTime)
+                   && ((2 * static_cast<uint64_t>(Player::MIN_BYTES_PER_INDEXING_THREAD)) <= recFileSize)
+                   && initializeMemoryMapping()) {
+            // Use a temporary memory mapping to index large files in parallel; Envelopes are still read from file.
+            std::cerr << "[cluon::Player]: Indexing " << m_file << " using a temporary memory mapping." << std::endl;
+            totalBytesRead = indexMemoryMapping();
+            releaseMemoryMapping();
+        } else {
+            // Determine file size to display progress.
+            m_recFile.seekg(0, m_recFile.end);
+            int64_t fileLength = m_recFile.tellg();
+            m_recFile.seekg(0, m_recFile.beg);
+
+            // Read complete file and store file positions to envelopes to create
+            // index of available data. The actual reading of Envelopes is deferred.
             int32_t oldPercentage = -1;
+            // Buffer for the meta data of the current Envelope; payloads are skipped.
+            std::string frame;
+            // The position is tracked from the consumed bytes as tellg would call lseek for every Envelope.
+            uint64_t position{0};
             while (m_recFile.good()) {
-                const uint64_t POS_BEFORE = static_cast<uint64_t>(m_recFile.tellg());
-                auto retVal               = extractEnvelope(m_recFile);
-                const uint64_t POS_AFTER  = static_cast<uint64_t>(m_recFile.tellg());
+                const uint64_t POS_BEFORE{position};
+                uint64_t consumedBytes{0};
+                auto retVal = scanEnvelopeView(m_recFile, frame, consumedBytes);
+                position += consumedBytes;
 
-                if (!m_recFile.eof() && retVal.first) {
-                    totalBytesRead += (POS_AFTER - POS_BEFORE);
+                // A successfully scanned Envelope is complete even if its last byte set the eofbit.
+                if (retVal.first) {
+                    totalBytesRead += consumedBytes;
 
                     // Store mapping .rec file position --> index entry.
                     const int64_t microseconds = cluon::time::toMicroseconds(retVal.second.sampleTimeStamp());
-                    m_index.emplace(std::make_pair(microseconds, IndexEntry(microseconds, POS_BEFORE)));
+                    m_index.emplace_back(IndexEntry(microseconds, POS_BEFORE, retVal.second.dataType(), retVal.second.senderStamp()));
 
-                    const int32_t percentage = static_cast<int32_t>((static_cast<float>(m_recFile.tellg()) * 100.0f) / static_cast<float>(fileLength));
+                    const int32_t percentage = static_cast<int32_t>((static_cast<float>(position) * 100.0f) / static_cast<float>(fileLength));
                     if ((percentage % 5 == 0) && (percentage != oldPercentage)) {
                         std::cerr << "[cluon::Player]: Indexed " << percentage << "% from " << m_file << "." << std::endl;
                         oldPercentage = percentage;
@@ -116,16 +176,341 @@ void Player::initializeIndex() noexcept {
                 }
             }
         }
+        // Sort chronologically while keeping the order from the file for identical sample time stamps.
+        std::stable_sort(m_index.begin(), m_index.end(), [](const IndexEntry &a, const IndexEntry &b) {
+            return a.m_sampleTimeStamp < b.m_sampleTimeStamp;
+        });
         const cluon::data::TimeStamp AFTER{cluon::time::now()};
 
         std::cerr << "[cluon::Player]: " << m_file << " contains " << m_index.size() << " entries; "
                   << "read " << totalBytesRead << " bytes "
                   << "in " << cluon::time::deltaInMicroseconds(AFTER, BEFORE) / static_cast<int64_t>(1000 * 1000) << "s." << std::endl;
+
+        storeIndexFile();
     } else {
         std::cerr << "[cluon::Player]: " << m_file << " could not be opened." << std::endl;
     }
 }
 
+bool Player::initializeMemoryMapping() noexcept {
+#ifdef WIN32
+    return false;
+#else
+    const int fd = ::open(m_file.c_str(), O_RDONLY); /* Flawfinder: ignore */
+    if (-1 == fd) {
+        return false;
+    }
+    struct stat fileStatus;
+    if ((-1 == ::fstat(fd, &fileStatus)) || (0 >= fileStatus.st_size)) {
+        ::close(fd);
+        return false;
+    }
+    const std::size_t FILE_SIZE{static_cast<std::size_t>(fileStatus.st_size)};
+    void *mapping = ::mmap(nullptr, FILE_SIZE, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after closing the file descriptor.
+    ::close(fd);
+    if (MAP_FAILED == mapping) {
+        return false;
+    }
+    m_mapping      = static_cast<const char *>(mapping);
+    m_mappingSize  = FILE_SIZE;
+    m_recFileValid = true;
+    return true;
+#endif
+}
+
+void Player::releaseMemoryMapping() noexcept {
+#ifndef WIN32
+    if (nullptr != m_mapping) {
+        ::munmap(const_cast<char *>(m_mapping), m_mappingSize);
+    }
+#endif
+    m_mapping     = nullptr;
+    m_mappingSize = 0;
+}
+
+uint64_t Player::indexMemoryMapping() noexcept {
+    uint64_t totalBytesRead{0};
+#ifndef WIN32
+    // The index is created by reading the file sequentially (per thread).
+    ::madvise(const_cast<char *>(m_mapping), m_mappingSize, MADV_SEQUENTIAL);
+
+    // Use one thread per core for large files; hardware_concurrency returns 0 if unknown.
+    const std::size_t NUMBER_OF_THREADS{(std::max<std::size_t>)(
+        1,
+        (std::min<std::size_t>)(static_cast<std::size_t>(std::thread::hardware_concurrency()),
+                                m_mappingSize / static_cast<std::size_t>(Player::MIN_BYTES_PER_INDEXING_THREAD)))};
+
+    std::vector<IndexEntry> entries;
+    if (1 == NUMBER_OF_THREADS) {
+        totalBytesRead = indexRange(m_mapping, m_mappingSize, 0, m_mappingSize, entries);
+    } else {
+        std::cerr << "[cluon::Player]: Indexing " << m_file << " using " << NUMBER_OF_THREADS << " threads." << std::endl;
+
+        // Each thread indexes all Envelopes starting within its byte range.
+        const std::size_t RANGE{m_mappingSize / NUMBER_OF_THREADS};
+        std::vector<std::size_t> begins(NUMBER_OF_THREADS, 0);
+        std::vector<std::size_t> ends(NUMBER_OF_THREADS, 0);
+        std::vector<std::size_t> starts(NUMBER_OF_THREADS, 0);
+        std::vector<std::size_t> stops(NUMBER_OF_THREADS, 0);
+        std::vector<std::vector<IndexEntry>> entriesPerRange(NUMBER_OF_THREADS);
+        std::vector<std::thread> threads;
+        try {
+            for (std::size_t i{0}; i < NUMBER_OF_THREADS; i++) {
+                begins[i] = i * RANGE;
+                ends[i]   = ((NUMBER_OF_THREADS - 1) == i) ? m_mappingSize : (i + 1) * RANGE;
+                threads.emplace_back([this, i, &begins, &ends, &starts, &stops, &entriesPerRange]() noexcept {
+                    starts[i] = (0 == i) ? 0 : resynchronize(m_mapping, m_mappingSize, begins[i], ends[i]);
+                    stops[i]  = indexRange(m_mapping, m_mappingSize, starts[i], ends[i], entriesPerRange[i]);
+                });
+            }
+        } catch (...) {} // LCOV_EXCL_LINE
+        for (auto &t : threads) {
+            t.join();
+        }
+        if (NUMBER_OF_THREADS != threads.size()) {
+            // Not all threads could be started; index sequentially instead.
+            totalBytesRead = indexRange(m_mapping, m_mappingSize, 0, m_mappingSize, entries); // LCOV_EXCL_LINE
+        } else {
+            // Stitch the ranges together: A range is only accepted if it starts exactly
+            // where the preceding range ended; otherwise, the resynchronization hit
+            // OD4 magic bytes inside a payload and the range is indexed again from the
+            // correct position. Thus, the result equals sequential indexing.
+            std::size_t expected{0};
+            for (std::size_t i{0}; i < NUMBER_OF_THREADS; i++) {
+                if (expected >= ends[i]) {
+                    // Preceding Envelope spans this complete range.
+                    continue;
+                }
+                if (starts[i] != expected) {
+                    entriesPerRange[i].clear();
+                    stops[i] = indexRange(m_mapping, m_mappingSize, expected, ends[i], entriesPerRange[i]);
+                }
+                entries.insert(entries.end(), entriesPerRange[i].begin(), entriesPerRange[i].end());
+                expected = stops[i];
+                if (expected < ends[i]) {
+                    // Invalid data; stop indexing like the sequential indexing would do.
+                    break;
+                }
+            }
+            totalBytesRead = expected;
+        }
+    }
+
+    m_index = std::move(entries);
+
+    // Replay accesses the mapping in sample time order.
+    ::madvise(const_cast<char *>(m_mapping), m_mappingSize, MADV_NORMAL);
+#endif
+    return totalBytesRead;
+}
+
+std::size_t Player::indexRange(const char *data, std::size_t size, std::size_t begin, std::size_t end, std::vector<IndexEntry> &entries) noexcept {
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    std::size_t position{begin};
+    while ((position < end) && ((position + OD4_HEADER_SIZE) <= size)) {
+        auto retVal = extractEnvelopeView(data + position, size - position);
+        if (!retVal.first) {
+            break;
+        }
+        uint32_t length{0};
+        std::memcpy(&length, data + position + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+
+        // Store mapping position in memory-mapped .rec file --> index entry.
+        const int64_t microseconds = cluon::time::toMicroseconds(retVal.second.sampleTimeStamp());
+        try {
+            entries.emplace_back(IndexEntry(microseconds, position, retVal.second.dataType(), retVal.second.senderStamp()));
+        } catch (...) { // LCOV_EXCL_LINE
+            break;      // LCOV_EXCL_LINE
+        }
+        position += OD4_HEADER_SIZE + (le32toh(length) >> 8);
+    }
+    return position;
+}
+
+std::size_t Player::resynchronize(const char *data, std::size_t size, std::size_t begin, std::size_t end) noexcept {
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    for (std::size_t position{begin}; (position < end) && ((position + OD4_HEADER_SIZE) <= size); position++) {
+        if ((0x0D == static_cast<uint8_t>(data[position])) && (0xA4 == static_cast<uint8_t>(data[position + 1]))) {
+            // Candidate must be a decodable Envelope that is followed by another OD4 header or the end of file.
+            if (extractEnvelopeView(data + position, size - position).first) {
+                uint32_t length{0};
+                std::memcpy(&length, data + position + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+                const std::size_t NEXT{position + OD4_HEADER_SIZE + (le32toh(length) >> 8)};
+                if ((NEXT == size)
+                    || (((NEXT + 1) < size) && (0x0D == static_cast<uint8_t>(data[NEXT])) && (0xA4 == static_cast<uint8_t>(data[NEXT + 1])))) {
+                    return position;
+                }
+            }
+        }
+    }
+    return end;
+}
+
+bool Player::getRecFileState(const std::string &file, uint64_t &size, int64_t &modificationTime) noexcept {
+    struct stat fileStatus;
+    bool retVal{0 == ::stat(file.c_str(), &fileStatus)};
+    if (retVal) {
+        size = static_cast<uint64_t>(fileStatus.st_size);
+#if defined(__APPLE__)
+        modificationTime = static_cast<int64_t>(fileStatus.st_mtimespec.tv_sec) * 1000 * 1000 * 1000 + static_cast<int64_t>(fileStatus.st_mtimespec.tv_nsec);
+#elif defined(WIN32)
+        modificationTime = static_cast<int64_t>(fileStatus.st_mtime) * 1000 * 1000 * 1000;
+#else
+        modificationTime = static_cast<int64_t>(fileStatus.st_mtim.tv_sec) * 1000 * 1000 * 1000 + static_cast<int64_t>(fileStatus.st_mtim.tv_nsec);
+#endif
+    }
+    return retVal;
+}
+
+bool Player::loadIndexFile() noexcept {
+    uint64_t recFileSize{0};
+    int64_t recFileModificationTime{0};
+    if (!getRecFileState(m_file, recFileSize, recFileModificationTime)) {
+        return false;
+    }
+
+    std::fstream indexFile(m_file + ".idx", std::ios_base::in | std::ios_base::binary);
+    if (!indexFile.good()) {
+        return false;
+    }
+
+    uint32_t magic{0};
+    uint32_t version{0};
+    uint64_t size{0};
+    int64_t modificationTime{0};
+    uint64_t numberOfEntries{0};
+    indexFile.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    indexFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+    indexFile.read(reinterpret_cast<char *>(&size), sizeof(size));
+    indexFile.read(reinterpret_cast<char *>(&modificationTime), sizeof(modificationTime));
+    indexFile.read(reinterpret_cast<char *>(&numberOfEntries), sizeof(numberOfEntries));
+    numberOfEntries = le64toh(numberOfEntries);
+
+    // The index file is only valid for the same .rec file in the same state.
+    if (!indexFile.good() || (static_cast<uint32_t>(Player::INDEX_FILE_MAGIC) != le32toh(magic)) || (static_cast<uint32_t>(Player::INDEX_FILE_VERSION) != le32toh(version))
+        || (recFileSize != le64toh(size)) || (recFileModificationTime != static_cast<int64_t>(le64toh(static_cast<uint64_t>(modificationTime))))
+        || (numberOfEntries > recFileSize / Player::MIN_RECORD_SIZE)) {
+        return false;
+    }
+
+    std::string entries(static_cast<std::size_t>(numberOfEntries) * Player::INDEX_FILE_ENTRY_SIZE, '\0');
+    if (!entries.empty()) {
+        indexFile.read(&entries[0], static_cast<std::streamsize>(entries.size()));
+        if (static_cast<std::streamsize>(entries.size()) != indexFile.gcount()) {
+            return false;
+        }
+    }
+
+    // Size and modification time might match a rewritten .rec file; thus, every entry must point at an OD4 record.
+    std::fstream recFile(m_file, std::ios_base::in | std::ios_base::binary);
+    if (!recFile.good()) {
+        return false; // LCOV_EXCL_LINE
+    }
+    constexpr uint8_t OD4_HEADER_SIZE{5};
+    char header[OD4_HEADER_SIZE];
+
+    std::vector<IndexEntry> index;
+    index.reserve(static_cast<std::size_t>(numberOfEntries));
+    for (std::size_t i{0}; i < entries.size(); i += Player::INDEX_FILE_ENTRY_SIZE) {
+        uint64_t sampleTimeStamp{0};
+        uint64_t filePosition{0};
+        uint32_t dataType{0};
+        uint32_t senderStamp{0};
+        std::memcpy(&sampleTimeStamp, &entries[i], sizeof(uint64_t)); /* Flawfinder: ignore */ // NOLINT
+        std::memcpy(&filePosition, &entries[i + 8], sizeof(uint64_t)); /* Flawfinder: ignore */ // NOLINT
+        std::memcpy(&dataType, &entries[i + 16], sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+        std::memcpy(&senderStamp, &entries[i + 20], sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+        filePosition = le64toh(filePosition);
+        if ((filePosition >= recFileSize) || (recFileSize - filePosition < Player::MIN_RECORD_SIZE)) {
+            return false;
+        }
+        recFile.seekg(static_cast<std::streamoff>(filePosition));
+        if (!recFile.read(header, OD4_HEADER_SIZE) || (0x0D != static_cast<uint8_t>(header[0])) || (0xA4 != static_cast<uint8_t>(header[1]))) {
+            return false;
+        }
+        uint32_t length{0};
+        std::memcpy(&length, header + 1, sizeof(uint32_t)); /* Flawfinder: ignore */ // NOLINT
+        if ((le32toh(length) >> 8) > (recFileSize - filePosition - OD4_HEADER_SIZE)) {
+            return false;
+        }
+        const int64_t microseconds{static_cast<int64_t>(le64toh(sampleTimeStamp))};
+        // Entries are stored chronologically.
+        if (!index.empty() && (microseconds < index.back().m_sampleTimeStamp)) {
+            return false;
+        }
+        index.emplace_back(IndexEntry(microseconds, filePosition, static_cast<int32_t>(le32toh(dataType)), le32toh(senderStamp)));
+    }
+    m_index = std::move(index);
+    return true;
+}
+
+void Player::storeIndexFile() const noexcept {
+    uint64_t recFileSize{0};
+    int64_t recFileModificationTime{0};
+    if (!getRecFileState(m_file, recFileSize, recFileModificationTime)) {
+        return; // LCOV_EXCL_LINE
+    }
+
+    std::string buffer;
+    buffer.reserve(Player::INDEX_FILE_HEADER_SIZE + m_index.size() * Player::INDEX_FILE_ENTRY_SIZE);
+    auto append = [&buffer](const void *data, std::size_t length) { buffer.append(static_cast<const char *>(data), length); };
+
+    const uint32_t MAGIC{htole32(static_cast<uint32_t>(Player::INDEX_FILE_MAGIC))};
+    const uint32_t VERSION{htole32(static_cast<uint32_t>(Player::INDEX_FILE_VERSION))};
+    const uint64_t SIZE{htole64(recFileSize)};
+    const uint64_t MODIFICATION_TIME{htole64(static_cast<uint64_t>(recFileModificationTime))};
+    const uint64_t NUMBER_OF_ENTRIES{htole64(static_cast<uint64_t>(m_index.size()))};
+    append(&MAGIC, sizeof(MAGIC));
+    append(&VERSION, sizeof(VERSION));
+    append(&SIZE, sizeof(SIZE));
+    append(&MODIFICATION_TIME, sizeof(MODIFICATION_TIME));
+    append(&NUMBER_OF_ENTRIES, sizeof(NUMBER_OF_ENTRIES));
+
+    // Entries are stored in the order of the index, i.e., sorted by sample time stamp.
+    for (const auto &e : m_index) {
+        const uint64_t SAMPLE_TIME_STAMP{htole64(static_cast<uint64_t>(e.m_sampleTimeStamp))};
+        const uint64_t FILE_POSITION{htole64(e.m_filePosition)};
+        const uint32_t DATA_TYPE{htole32(static_cast<uint32_t>(e.m_dataType))};
+        const uint32_t SENDER_STAMP{htole32(e.m_senderStamp)};
+        append(&SAMPLE_TIME_STAMP, sizeof(SAMPLE_TIME_STAMP));
+        append(&FILE_POSITION, sizeof(FILE_POSITION));
+        append(&DATA_TYPE, sizeof(DATA_TYPE));
+        append(&SENDER_STAMP, sizeof(SENDER_STAMP));
+    }
+
+    // Write to a temporary file first so that concurrent Players never read a partial index;
+    // its name is unique per process and Player so that concurrent writers do not interfere.
+    static std::atomic<uint32_t> numberOfIndexFiles{0};
+#ifdef WIN32
+    const int PID{::_getpid()};
+#else
+    const int PID{static_cast<int>(::getpid())};
+#endif
+    const std::string INDEX_FILE{m_file + ".idx"};
+    const std::string TMP_INDEX_FILE{INDEX_FILE + ".tmp." + std::to_string(PID) + "." + std::to_string(numberOfIndexFiles++)};
+    {
+        std::fstream indexFile(TMP_INDEX_FILE, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!indexFile.good()) {
+            // Directory might be read-only; the index will be recreated next time.
+            return;
+        }
+        indexFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        indexFile.flush();
+        if (!indexFile.good()) {
+            indexFile.close();
+            std::remove(TMP_INDEX_FILE.c_str()); // LCOV_EXCL_LINE
+            return;                              // LCOV_EXCL_LINE
+        }
+    }
+#ifdef WIN32
+    std::remove(INDEX_FILE.c_str());
+#endif
+    if (0 != std::rename(TMP_INDEX_FILE.c_str(), INDEX_FILE.c_str())) {
+        std::remove(TMP_INDEX_FILE.c_str()); // LCOV_EXCL_LINE
+    }
+}
+
 void Player::resetCaches() noexcept {
     try {
         std::lock_guard<std::mutex> lck(m_indexMutex);
@@ -139,57 +524,59 @@ void Player::resetIterators() noexcept {
     try {
         std::lock_guard<std::mutex> lck(m_indexMutex);
         // Point to first entry in index.
-        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = m_index.begin();
-        // Invalidate iterator for erasing entries point.
-        m_previousPreviousEnvelopeAlreadyReplayed = m_index.end();
+        m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay = 0;
+        // Invalidate position for erasing entries point.
+        m_previousPreviousEnvelopeAlreadyReplayed = m_index.size();
     } catch (...) {} // LCOV_EXCL_LINE
 }
 
 void Player::computeInitialCacheLevelAndFillCache() noexcept {
     if (m_recFileValid && (m_index.size() > 0)) {
-        int64_t smallestSampleTimePoint = (std::numeric_limits<int64_t>::max)();
-        int64_t largestSampleTimePoint  = (std::numeric_limits<int64_t>::min)();
-        for (auto it = m_index.begin(); it != m_index.end(); it++) {
-            smallestSampleTimePoint = (std::min)(smallestSampleTimePoint, it->first);
-            largestSampleTimePoint  = (std::max)(largestSampleTimePoint, it->first);
-        }
+        // Index is sorted chronologically.
+        const int64_t smallestSampleTimePoint = m_index.front().m_sampleTimeStamp;
+        const int64_t largestSampleTimePoint  = m_index.back().m_sampleTimeStamp;
 
         const uint32_t ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY
             = static_cast<uint32_t>(std::ceil(static_cast<float>(m_index.size()) * (static_cast<float>(Player::ONE_SECOND_IN_MICROSECONDS))
                                               / static_cast<float>(largestSampleTimePoint - smallestSampleTimePoint)));
         m_desiredInitialLevel = (std::max<uint32_t>)(ENTRIES_TO_READ_PER_SECOND_FOR_REALTIME_REPLAY * Player::LOOK_AHEAD_IN_S, MIN_ENTRIES_FOR_LOOK_AHEAD);
 
-        std::cerr << "[cluon::Player]: Initializing cache with " << m_desiredInitialLevel << " entries." << std::endl;
-
         resetCaches();
         resetIterators();
-        fillEnvelopeCache(m_desiredInitialLevel);
+        // The page cache replaces the Envelope cache for memory-mapped files.
+        if (!m_memoryMapped) {
+            std::cerr << "[cluon::Player]: Initializing cache with " << m_desiredInitialLevel << " entries." << std::endl;
+            fillEnvelopeCache(m_desiredInitialLevel);
+        }
     }
 }
 
 uint32_t Player::fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToReadFromFile) noexcept {
     uint32_t entriesReadFromFile = 0;
-    if (m_recFileValid && (maxNumberOfEntriesToReadFromFile > 0)) {
+    if (m_recFileValid && !m_memoryMapped && (maxNumberOfEntriesToReadFromFile > 0)) {
         // Reset any fstream's error states.
         m_recFile.clear();
 
-        while ((m_nextEntryToReadFromRecFile != m_index.end()) && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile)) {
+        while ((m_nextEntryToReadFromRecFile != m_index.size()) && (entriesReadFromFile < maxNumberOfEntriesToReadFromFile)) {
             // Move to corresponding position in the .rec file.
-            m_recFile.seekg(static_cast<std::streamoff>(m_nextEntryToReadFromRecFile->second.m_filePosition));
+            m_recFile.seekg(static_cast<std::streamoff>(m_index[m_nextEntryToReadFromRecFile].m_filePosition));
 
             // Read the corresponding cluon::data::Envelope.
             auto retVal = extractEnvelope(m_recFile);
-            if (retVal.first) {
-                // Store the envelope in the envelope cache.
-                try {
-                    std::lock_guard<std::mutex> lck(m_indexMutex);
-                    m_nextEntryToReadFromRecFile->second.m_available
-                        = m_envelopeCache.emplace(std::make_pair(m_nextEntryToReadFromRecFile->second.m_filePosition, retVal.second)).second;
-                } catch (...) {} // LCOV_EXCL_LINE
-
+            try {
+                std::lock_guard<std::mutex> lck(m_indexMutex);
+                if (retVal.first) {
+                    // Store the envelope in the envelope cache.
+                    m_index[m_nextEntryToReadFromRecFile].m_available
+                        = m_envelopeCache.emplace(std::make_pair(m_index[m_nextEntryToReadFromRecFile].m_filePosition, retVal.second)).second;
+                    entriesReadFromFile++;
+                } else {
+                    // Skip entries that cannot be decoded instead of retrying them.
+                    m_recFile.clear();
+                    m_numberOfSkippedEntries++;
+                }
                 m_nextEntryToReadFromRecFile++;
-                entriesReadFromFile++;
-            }
+            } catch (...) {} // LCOV_EXCL_LINE
         }
     }
 
@@ -197,11 +584,16 @@ uint32_t Player::fillEnvelopeCache(const uint32_t &maxNumberOfEntriesToReadFromF
 }
 
 std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplayed() noexcept {
+    if (m_memoryMapped) {
+        auto retVal = getNextEnvelopeViewToBeReplayed();
+        return std::make_pair(retVal.first, (retVal.first ? retVal.second.envelope() : cluon::data::Envelope()));
+    }
+
     bool hasEnvelopeToReturn{false};
     cluon::data::Envelope envelopeToReturn;
 
     // If at "EOF", either throw exception or autorewind.
-    if (m_currentEnvelopeToReplay == m_index.end()) {
+    if (m_currentEnvelopeToReplay == m_index.size()) {
         if (!m_autoRewind) {
             return std::make_pair(hasEnvelopeToReturn, envelopeToReturn);
         } else {
@@ -209,21 +601,26 @@ std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplayed() noe
         }
     }
 
-    if (m_currentEnvelopeToReplay != m_index.end()) {
+    while (!hasEnvelopeToReturn && (m_currentEnvelopeToReplay != m_index.size())) {
         checkAvailabilityOfNextEnvelopeToBeReplayed();
 
         try {
             {
                 std::lock_guard<std::mutex> lck(m_indexMutex);
 
-                cluon::data::Envelope &nextEnvelope = m_envelopeCache[m_currentEnvelopeToReplay->second.m_filePosition];
-                envelopeToReturn                    = nextEnvelope;
+                auto nextEnvelope = m_envelopeCache.find(m_index[m_currentEnvelopeToReplay].m_filePosition);
+                if (nextEnvelope == m_envelopeCache.end()) {
+                    // The entry could not be decoded from the .rec file.
+                    m_currentEnvelopeToReplay++;
+                    continue;
+                }
+                envelopeToReturn = nextEnvelope->second;
 
-                m_delay = static_cast<uint32_t>(m_currentEnvelopeToReplay->first - m_previousEnvelopeAlreadyReplayed->first);
+                m_delay = static_cast<uint32_t>(m_index[m_currentEnvelopeToReplay].m_sampleTimeStamp - m_index[m_previousEnvelopeAlreadyReplayed].m_sampleTimeStamp);
 
                 // TODO: Delegate deleting into own thread.
-                if (m_previousPreviousEnvelopeAlreadyReplayed != m_index.end()) {
-                    auto it = m_envelopeCache.find(m_previousEnvelopeAlreadyReplayed->second.m_filePosition);
+                if (m_previousPreviousEnvelopeAlreadyReplayed != m_index.size()) {
+                    auto it = m_envelopeCache.find(m_index[m_previousEnvelopeAlreadyReplayed].m_filePosition);
                     if (it != m_envelopeCache.end()) {
                         m_envelopeCache.erase(it);
                     }
@@ -249,20 +646,63 @@ std::pair<bool, cluon::data::Envelope> Player::getNextEnvelopeToBeReplayed() noe
     return std::make_pair(hasEnvelopeToReturn, envelopeToReturn);
 }
 
+std::pair<bool, cluon::EnvelopeView> Player::getNextEnvelopeViewToBeReplayed() noexcept {
+    std::pair<bool, cluon::EnvelopeView> retVal{false, cluon::EnvelopeView()};
+    if (!m_memoryMapped) {
+        auto next = getNextEnvelopeToBeReplayed();
+        if (next.first) {
+            m_envelopeViewBuffer = cluon::serializeEnvelope(std::move(next.second));
+            retVal               = extractEnvelopeView(m_envelopeViewBuffer.data(), m_envelopeViewBuffer.size());
+        }
+        return retVal;
+    }
+
+    // If at "EOF", either throw exception or autorewind.
+    if (m_currentEnvelopeToReplay == m_index.size()) {
+        if (!m_autoRewind) {
+            return retVal;
+        } else {
+            rewind();
+        }
+    }
+
+    if (m_currentEnvelopeToReplay != m_index.size()) {
+        try {
+            std::lock_guard<std::mutex> lck(m_indexMutex);
+
+            const uint64_t POSITION{m_index[m_currentEnvelopeToReplay].m_filePosition};
+            retVal = extractEnvelopeView(m_mapping + POSITION, m_mappingSize - static_cast<std::size_t>(POSITION));
+
+            m_delay = static_cast<uint32_t>(m_index[m_currentEnvelopeToReplay].m_sampleTimeStamp - m_index[m_previousEnvelopeAlreadyReplayed].m_sampleTimeStamp);
+
+            m_previousPreviousEnvelopeAlreadyReplayed = m_previousEnvelopeAlreadyReplayed;
+            m_previousEnvelopeAlreadyReplayed         = m_currentEnvelopeToReplay++;
+
+            m_numberOfReturnedEnvelopesInTotal++;
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+    return retVal;
+}
+
 void Player::checkAvailabilityOfNextEnvelopeToBeReplayed() noexcept {
-    uint64_t numberOfEntries = 0;
+    // The next entry is either in the cache or was skipped once the reader has passed it.
+    bool available{false};
     do {
         {
             try {
                 std::lock_guard<std::mutex> lck(m_indexMutex);
-                numberOfEntries = m_envelopeCache.size();
+                available = (m_nextEntryToReadFromRecFile > m_currentEnvelopeToReplay);
             } catch (...) {} // LCOV_EXCL_LINE
         }
-        if (0 == numberOfEntries) {
-            using namespace std::chrono_literals; // LCOV_EXCL_LINE
-            std::this_thread::sleep_for(10ms);    // LCOV_EXCL_LINE
+        if (!available) {
+            if (!m_threading) {
+                fillEnvelopeCache(1); // LCOV_EXCL_LINE
+            } else {
+                using namespace std::chrono_literals; // LCOV_EXCL_LINE
+                std::this_thread::sleep_for(10ms);    // LCOV_EXCL_LINE
+            }
         }
-    } while (0 == numberOfEntries);
+    } while (!available && m_recFileValid);
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -272,6 +712,11 @@ uint32_t Player::totalNumberOfEnvelopesInRecFile() const noexcept {
     return static_cast<uint32_t>(m_index.size());
 }
 
+uint32_t Player::numberOfSkippedEnvelopes() const noexcept {
+    std::lock_guard<std::mutex> lck(m_indexMutex);
+    return static_cast<uint32_t>(m_numberOfSkippedEntries);
+}
+
 uint32_t Player::delay() const noexcept {
     std::lock_guard<std::mutex> lck(m_indexMutex);
     // Make sure that delay is not exceeding the specified maximum delay.
@@ -296,56 +741,91 @@ void Player::rewind() noexcept {
 
 void Player::seekTo(float ratio) noexcept {
     if (!(ratio < 0) && !(ratio > 1)) {
-        bool enableThreading = m_threading;
-        if (m_threading) {
-            // Stop concurrent thread.
-            setEnvelopeCacheFillingRunning(false);
-            m_envelopeCacheFillingThread.join();
-        }
-
-        // Read data sequentially.
-        m_threading = false;
-
-        resetCaches();
-        resetIterators();
-
         uint32_t numberOfEntriesInIndex = 0;
         try {
             std::lock_guard<std::mutex> lck(m_indexMutex);
             numberOfEntriesInIndex = static_cast<uint32_t>(m_index.size());
         } catch (...) {} // LCOV_EXCL_LINE
 
-        // Fast forward.
-        m_numberOfReturnedEnvelopesInTotal = 0;
         std::cerr << "[cluon::Player]: Seeking to " << static_cast<float>(numberOfEntriesInIndex) * ratio << "/" << numberOfEntriesInIndex << std::endl;
+        std::size_t position{0};
         if (0 < ratio) {
-            for (m_numberOfReturnedEnvelopesInTotal = 0;
-                 m_numberOfReturnedEnvelopesInTotal < static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio) - 1;
-                 m_numberOfReturnedEnvelopesInTotal++) {
-                m_currentEnvelopeToReplay++;
-            }
+            position = (std::max<uint32_t>)(static_cast<uint32_t>(static_cast<float>(numberOfEntriesInIndex) * ratio), 1) - 1;
         }
-        try {
-            std::lock_guard<std::mutex> lck(m_indexMutex);
-            m_nextEntryToReadFromRecFile = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay;
-        } catch (...) {} // LCOV_EXCL_LINE
-
-        // Refill cache.
-        m_envelopeCache.clear();
-        fillEnvelopeCache(static_cast<uint32_t>(static_cast<float>(m_desiredInitialLevel) * .3f));
+        seekToPosition(position);
 
         // Correct iterators if not at the beginning.
         if ((0 < ratio) && (ratio < 1)) {
             getNextEnvelopeToBeReplayed();
         }
         std::cerr << "[cluon::Player]: Seeking done." << std::endl;
+    }
+}
 
-        if (enableThreading) {
-            m_threading = enableThreading;
-            // Re-start concurrent thread.
-            setEnvelopeCacheFillingRunning(true);
-            m_envelopeCacheFillingThread = std::thread(&Player::manageCache, this);
+void Player::seekToTimeStamp(const cluon::data::TimeStamp &timeStamp) noexcept {
+    const int64_t SAMPLE_TIME_STAMP{cluon::time::toMicroseconds(timeStamp)};
+    std::size_t position{0};
+    try {
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+        position = findPosition(SAMPLE_TIME_STAMP);
+    } catch (...) {} // LCOV_EXCL_LINE
+
+    std::cerr << "[cluon::Player]: Seeking to " << SAMPLE_TIME_STAMP << " (" << position << ")" << std::endl;
+    seekToPosition(position);
+}
+
+void Player::seekBy(int64_t microseconds) noexcept {
+    std::size_t position{0};
+    try {
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+        if (!m_index.empty()) {
+            // Seek relative to the next Envelope to be replayed.
+            const int64_t SAMPLE_TIME_STAMP{m_index[(std::min)(m_currentEnvelopeToReplay, m_index.size() - 1)].m_sampleTimeStamp};
+            position = findPosition(SAMPLE_TIME_STAMP + microseconds);
         }
+    } catch (...) {} // LCOV_EXCL_LINE
+
+    std::cerr << "[cluon::Player]: Seeking by " << microseconds << " (" << position << ")" << std::endl;
+    seekToPosition(position);
+}
+
+std::size_t Player::findPosition(int64_t sampleTimeStamp) const noexcept {
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), sampleTimeStamp, [](const IndexEntry &e, const int64_t &ts) {
+        return e.m_sampleTimeStamp < ts;
+    });
+    return static_cast<std::size_t>(std::distance(m_index.begin(), it));
+}
+
+void Player::seekToPosition(std::size_t position) noexcept {
+    bool enableThreading = m_threading;
+    if (m_threading) {
+        // Stop concurrent thread.
+        setEnvelopeCacheFillingRunning(false);
+        m_envelopeCacheFillingThread.join();
+    }
+
+    // Read data sequentially.
+    m_threading = false;
+
+    resetCaches();
+    resetIterators();
+
+    try {
+        std::lock_guard<std::mutex> lck(m_indexMutex);
+        m_currentEnvelopeToReplay          = (std::min)(position, m_index.size());
+        m_nextEntryToReadFromRecFile       = m_previousEnvelopeAlreadyReplayed = m_currentEnvelopeToReplay;
+        m_numberOfReturnedEnvelopesInTotal = m_currentEnvelopeToReplay;
+    } catch (...) {} // LCOV_EXCL_LINE
+
+    // Refill cache only around the new position.
+    m_envelopeCache.clear();
+    fillEnvelopeCache(static_cast<uint32_t>(static_cast<float>(m_desiredInitialLevel) * .3f));
+
+    if (enableThreading) {
+        m_threading = enableThreading;
+        // Re-start concurrent thread.
+        setEnvelopeCacheFillingRunning(true);
+        m_envelopeCacheFillingThread = std::thread(&Player::manageCache, this);
     }
 }
 
@@ -358,7 +838,7 @@ bool Player::hasMoreDataFromRecFile() const noexcept {
     // File must be successfully opened AND
     //  the Player must be configured as m_autoRewind OR
     //  some entries are left to replay.
-    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_index.end())));
+    return (m_recFileValid && (m_autoRewind || (m_currentEnvelopeToReplay != m_index.size())));
 }
 
 ////////////////////////////////////////////////////////////////////////
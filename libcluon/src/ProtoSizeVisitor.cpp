@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/ProtoSizeVisitor.hpp"
+#include "cluon/ToProtoVisitor.hpp"
+
+namespace cluon {
+
+ProtoSizeVisitor::ProtoSizeVisitor(std::vector<std::size_t> &nestedSizes) noexcept
+    : m_nestedSizes{&nestedSizes} {}
+
+std::size_t ProtoSizeVisitor::encodedSize() const noexcept {
+    return m_size;
+}
+
+void ProtoSizeVisitor::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
+    (void)id;
+    (void)shortName;
+    (void)longName;
+}
+
+void ProtoSizeVisitor::postVisit() noexcept {}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, bool &v) noexcept {
+    (void)typeName;
+    (void)name;
+    (void)v;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + 1;
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, char &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(static_cast<uint8_t>(v));
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int8_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(ToProtoVisitor::toZigZag8(v));
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint8_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(v);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int16_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(ToProtoVisitor::toZigZag16(v));
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint16_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(v);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int32_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(ToProtoVisitor::toZigZag32(v));
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint32_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(v);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, int64_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(ToProtoVisitor::toZigZag64(v));
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, uint64_t &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::VARINT) + sizeOfVarInt(v);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, float &v) noexcept {
+    (void)typeName;
+    (void)name;
+    (void)v;
+    m_size += sizeOfKey(id, ProtoConstants::FOUR_BYTES) + sizeof(uint32_t);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
+    (void)typeName;
+    (void)name;
+    (void)v;
+    m_size += sizeOfKey(id, ProtoConstants::EIGHT_BYTES) + sizeof(uint64_t);
+}
+
+void ProtoSizeVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
+    (void)typeName;
+    (void)name;
+    m_size += sizeOfKey(id, ProtoConstants::LENGTH_DELIMITED) + sizeOfVarInt(v.size()) + v.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::size_t ProtoSizeVisitor::sizeOfVarInt(uint64_t v) const noexcept {
+    // Minimum size is of the encoded data.
+    std::size_t size{1};
+    while (0x7f < v) {
+        v >>= 7;
+        size++;
+    }
+    return size;
+}
+
+std::size_t ProtoSizeVisitor::sizeOfKey(uint32_t fieldIdentifier, ProtoConstants protoType) const noexcept {
+    return sizeOfVarInt((fieldIdentifier << 0x3) | static_cast<uint8_t>(protoType));
+}
+} // namespace cluon
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/Reactor.hpp"
+
+// clang-format off
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <unistd.h>
+#endif
+// clang-format on
+
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+namespace cluon {
+
+Reactor::Reactor(std::size_t numberOfThreads) noexcept {
+#ifdef __linux__
+    numberOfThreads = (0 < numberOfThreads) ? numberOfThreads : 1;
+    m_isOneShot     = (1 < numberOfThreads);
+    m_epollFD       = ::epoll_create1(EPOLL_CLOEXEC);
+    m_eventFD       = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (!(m_epollFD < 0) && !(m_eventFD < 0)) {
+        struct epoll_event event {};
+        event.events  = EPOLLIN;
+        event.data.fd = m_eventFD;
+        if (0 == ::epoll_ctl(m_epollFD, EPOLL_CTL_ADD, m_eventFD, &event)) {
+            m_processEventsThreadRunning.store(true);
+
+            // Constructing a thread could fail.
+            try {
+                m_processEventsThreads.reserve(numberOfThreads);
+                for (std::size_t i{0}; i < numberOfThreads; i++) {
+                    m_processEventsThreads.emplace_back(std::thread(&Reactor::processEvents, this));
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
+
+            // Let the operating system spawn the threads.
+            using namespace std::literals::chrono_literals; // NOLINT
+            while (m_numberOfStartedThreads.load() < m_processEventsThreads.size()) { std::this_thread::sleep_for(1ms); }
+            if (m_processEventsThreads.empty()) {
+                m_processEventsThreadRunning.store(false); // LCOV_EXCL_LINE
+            }
+        }
+    }
+    if (!m_processEventsThreadRunning.load()) {
+        std::cerr << "[cluon::Reactor] Failed to create event loop: " << errno << std::endl; // LCOV_EXCL_LINE
+    }
+#else
+    (void)numberOfThreads;
+#endif
+}
+
+Reactor::~Reactor() noexcept {
+    m_processEventsThreadRunning.store(false);
+
+#ifdef __linux__
+    if (!(m_eventFD < 0)) {
+        // Wake up the event loop immediately; the eventfd stays readable to wake up all threads.
+        const uint64_t WAKEUP{1};
+        auto retVal = ::write(m_eventFD, &WAKEUP, sizeof(WAKEUP));
+        (void)retVal;
+    }
+#endif
+
+    // Joining the threads could fail.
+    try {
+        for (auto &thread : m_processEventsThreads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+
+#ifdef __linux__
+    if (!(m_eventFD < 0)) {
+        ::close(m_eventFD);
+    }
+    if (!(m_epollFD < 0)) {
+        ::close(m_epollFD);
+    }
+#endif
+}
+
+std::size_t Reactor::numberOfThreadsFromEnvironment() noexcept {
+    std::size_t numberOfThreads{1};
+    const char *CLUON_REACTOR_THREADS = getenv("CLUON_REACTOR_THREADS");
+    if (nullptr != CLUON_REACTOR_THREADS) {
+        const long VALUE{std::strtol(CLUON_REACTOR_THREADS, nullptr, 10)};
+        constexpr long MAX_THREADS{64};
+        numberOfThreads = static_cast<std::size_t>((VALUE < 1) ? 1 : ((VALUE > MAX_THREADS) ? MAX_THREADS : VALUE));
+    }
+    return numberOfThreads;
+}
+
+bool Reactor::isRunning() const noexcept {
+    return m_processEventsThreadRunning.load();
+}
+
+std::size_t Reactor::numberOfThreads() const noexcept {
+    return m_processEventsThreads.size();
+}
+
+bool Reactor::isEventLoopThread() const noexcept {
+    const std::thread::id ID{std::this_thread::get_id()};
+    for (const auto &thread : m_processEventsThreads) {
+        if (ID == thread.get_id()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Reactor::arm(int32_t fd, bool readable) noexcept {
+#ifdef __linux__
+    // A paused file descriptor is disarmed after reporting a hang-up or an error once.
+    struct epoll_event event {};
+    event.events  = (readable ? EPOLLIN : 0u) | ((m_isOneShot || !readable) ? static_cast<uint32_t>(EPOLLONESHOT) : 0u);
+    event.data.fd = fd;
+    ::epoll_ctl(m_epollFD, EPOLL_CTL_MOD, fd, &event);
+#else
+    (void)fd;
+    (void)readable;
+#endif
+}
+
+bool Reactor::add(int32_t fd, std::function<void()> delegate) noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    if (isRunning() && !(fd < 0) && (nullptr != delegate)) {
+        try {
+            std::lock_guard<std::mutex> lck(m_delegatesMutex);
+            if (0 == m_delegates.count(fd)) {
+                struct epoll_event event {};
+                event.events  = EPOLLIN | (m_isOneShot ? static_cast<uint32_t>(EPOLLONESHOT) : 0u);
+                event.data.fd = fd;
+                if (0 == ::epoll_ctl(m_epollFD, EPOLL_CTL_ADD, fd, &event)) {
+                    m_delegates[fd] = std::make_shared<std::function<void()>>(std::move(delegate));
+                    retVal          = true;
+                }
+            }
+        } catch (...) {} // LCOV_EXCL_LINE
+    }
+#else
+    (void)fd;
+    (void)delegate;
+#endif
+    return retVal;
+}
+
+bool Reactor::remove(int32_t fd) noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    try {
+        std::unique_lock<std::mutex> lck(m_delegatesMutex);
+        auto element = m_delegates.find(fd);
+        if (element != m_delegates.end()) {
+            m_delegates.erase(element);
+            m_pausedFDs.erase(fd);
+            ::epoll_ctl(m_epollFD, EPOLL_CTL_DEL, fd, nullptr);
+            retVal = true;
+
+            // Wait for a running delegate unless we are called from a delegate.
+            if (!isEventLoopThread()) {
+                m_delegatesCondition.wait(lck, [this, fd] { return (0 == this->m_dispatchingFDs.count(fd)); });
+            }
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+#else
+    (void)fd;
+#endif
+    return retVal;
+}
+
+bool Reactor::pause(int32_t fd) noexcept {
+    bool retVal{false};
+    try {
+        std::lock_guard<std::mutex> lck(m_delegatesMutex);
+        if (0 < m_delegates.count(fd)) {
+            m_pausedFDs.insert(fd);
+            arm(fd, false);
+            retVal = true;
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+bool Reactor::resume(int32_t fd) noexcept {
+    bool retVal{false};
+    try {
+        std::lock_guard<std::mutex> lck(m_delegatesMutex);
+        if (0 < m_delegates.count(fd)) {
+            // A running one-shot delegate re-arms its file descriptor when it returns.
+            if ((0 < m_pausedFDs.erase(fd)) && !(m_isOneShot && (0 < m_dispatchingFDs.count(fd)))) {
+                arm(fd, true);
+            }
+            retVal = true;
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+void Reactor::processEvents() noexcept {
+#ifdef __linux__
+    constexpr int MAX_EVENTS{64};
+    std::array<struct epoll_event, MAX_EVENTS> events{};
+
+    // Indicate to main thread that we are ready.
+    m_numberOfStartedThreads++;
+
+    while (m_processEventsThreadRunning.load()) {
+        const int NUMBER_OF_EVENTS{::epoll_wait(m_epollFD, events.data(), (m_isOneShot ? 1 : MAX_EVENTS), -1)};
+        for (int i{0}; i < NUMBER_OF_EVENTS; i++) {
+            const int32_t FD{events[static_cast<std::size_t>(i)].data.fd};
+            if (FD == m_eventFD) {
+                continue;
+            }
+
+            // Delegates could have been removed or paused by previous delegates.
+            std::shared_ptr<std::function<void()>> delegate;
+            try {
+                std::lock_guard<std::mutex> lck(m_delegatesMutex);
+                auto element = m_delegates.find(FD);
+                if ((element != m_delegates.end()) && (0 == m_pausedFDs.count(FD))) {
+                    delegate = element->second;
+                    m_dispatchingFDs.insert(FD);
+                }
+            } catch (...) {} // LCOV_EXCL_LINE
+
+            if (delegate) {
+                (*delegate)();
+
+                try {
+                    std::lock_guard<std::mutex> lck(m_delegatesMutex);
+                    m_dispatchingFDs.erase(FD);
+                    if (m_isOneShot && (0 < m_delegates.count(FD)) && (0 == m_pausedFDs.count(FD))) {
+                        arm(FD, true);
+                    }
+                } catch (...) {} // LCOV_EXCL_LINE
+                m_delegatesCondition.notify_all();
+            }
+        }
+    }
+#endif
+}
+} // namespace cluon
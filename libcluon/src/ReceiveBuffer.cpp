@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/ReceiveBuffer.hpp"
+
+#include <utility>
+
+namespace cluon {
+
+ReceiveBuffer::ReceiveBuffer(std::shared_ptr<ReceiveBufferPool> pool, std::unique_ptr<char[]> &&slab, std::size_t capacity) noexcept
+    : m_pool(std::move(pool))
+    , m_slab(std::move(slab))
+    , m_capacity(capacity) {}
+
+ReceiveBuffer::ReceiveBuffer(ReceiveBuffer &&other) noexcept
+    : m_pool(std::move(other.m_pool))
+    , m_slab(std::move(other.m_slab))
+    , m_capacity(other.m_capacity)
+    , m_size(other.m_size) {
+    other.m_capacity = 0;
+    other.m_size     = 0;
+}
+
+ReceiveBuffer &ReceiveBuffer::operator=(ReceiveBuffer &&other) noexcept {
+    if (this != &other) {
+        release();
+        m_pool           = std::move(other.m_pool);
+        m_slab           = std::move(other.m_slab);
+        m_capacity       = other.m_capacity;
+        m_size           = other.m_size;
+        other.m_capacity = 0;
+        other.m_size     = 0;
+    }
+    return *this;
+}
+
+ReceiveBuffer::~ReceiveBuffer() noexcept {
+    release();
+}
+
+void ReceiveBuffer::release() noexcept {
+    if (m_pool && m_slab) {
+        m_pool->release(std::move(m_slab));
+    }
+    m_pool.reset();
+    m_slab.reset();
+    m_capacity = 0;
+    m_size     = 0;
+}
+
+char *ReceiveBuffer::data() noexcept {
+    return m_slab.get();
+}
+
+const char *ReceiveBuffer::data() const noexcept {
+    return m_slab.get();
+}
+
+std::size_t ReceiveBuffer::size() const noexcept {
+    return m_size;
+}
+
+void ReceiveBuffer::size(std::size_t size) noexcept {
+    m_size = (size < m_capacity) ? size : m_capacity;
+}
+
+std::size_t ReceiveBuffer::capacity() const noexcept {
+    return m_capacity;
+}
+
+std::string ReceiveBuffer::toString() const noexcept {
+    std::string retVal;
+    try {
+        if (m_slab) {
+            retVal.assign(m_slab.get(), m_size);
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    return retVal;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ReceiveBufferPool::ReceiveBufferPool(std::size_t slabSize, std::size_t maxFreeSlabs) noexcept
+    : m_slabSize(slabSize)
+    , m_maxFreeSlabs(maxFreeSlabs) {}
+
+ReceiveBuffer ReceiveBufferPool::acquire() noexcept {
+    std::unique_ptr<char[]> slab{nullptr};
+    try {
+        {
+            std::lock_guard<std::mutex> lck(m_freeSlabsMutex);
+            if (!m_freeSlabs.empty()) {
+                slab = std::move(m_freeSlabs.back());
+                m_freeSlabs.pop_back();
+            } else {
+                m_numberOfAllocatedSlabs++;
+            }
+        }
+        if (!slab) {
+            slab.reset(new char[m_slabSize]);
+        }
+        return ReceiveBuffer(shared_from_this(), std::move(slab), m_slabSize);
+    } catch (...) {} // LCOV_EXCL_LINE
+    return ReceiveBuffer(); // LCOV_EXCL_LINE
+}
+
+std::size_t ReceiveBufferPool::slabSize() const noexcept {
+    return m_slabSize;
+}
+
+std::size_t ReceiveBufferPool::numberOfFreeSlabs() noexcept {
+    std::lock_guard<std::mutex> lck(m_freeSlabsMutex);
+    return m_freeSlabs.size();
+}
+
+uint64_t ReceiveBufferPool::numberOfAllocatedSlabs() noexcept {
+    std::lock_guard<std::mutex> lck(m_freeSlabsMutex);
+    return m_numberOfAllocatedSlabs;
+}
+
+void ReceiveBufferPool::release(std::unique_ptr<char[]> &&slab) noexcept {
+    try {
+        std::lock_guard<std::mutex> lck(m_freeSlabsMutex);
+        if (m_freeSlabs.size() < m_maxFreeSlabs) {
+            m_freeSlabs.emplace_back(std::move(slab));
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+    // Slabs beyond maxFreeSlabs are freed here.
+    slab.reset();
+}
+} // namespace cluon
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "cluon/SocketFilter.hpp"
+
+namespace cluon {
+
+std::vector<SocketFilterInstruction> createEnvelopeDataTypeFilter(const std::vector<int32_t> &dataTypes) noexcept {
+    return createEnvelopeShardFilter(0, 1, dataTypes, true);
+}
+
+std::vector<SocketFilterInstruction> createEnvelopeShardFilter(uint32_t shard,
+                                                               uint32_t numberOfShards,
+                                                               const std::vector<int32_t> &dataTypes,
+                                                               bool filterDataTypes) noexcept {
+    // Socket filters for UDP see the UDP header (8 bytes) followed by the payload.
+    constexpr uint32_t UDP_HEADER_SIZE{8};
+    constexpr uint32_t OD4_HEADER_SIZE{5};
+    constexpr uint8_t DATATYPE_KEY{0x08}; // Field 1, varint.
+
+    std::vector<SocketFilterInstruction> program;
+    if ((0 == numberOfShards) || (shard >= numberOfShards)) {
+        return program;
+    }
+
+    try {
+        const bool SHARDED{1 < numberOfShards};
+        auto emit = [&program](uint16_t code, uint32_t k) { program.push_back({code, 0, 0, k}); };
+        auto loadByte = [&program](uint32_t offset) { program.push_back({SocketFilterInstruction::LOAD_BYTE_ABSOLUTE, 0, 0, UDP_HEADER_SIZE + offset}); };
+        auto jumpIfEqual = [&program](uint32_t value, uint8_t jt, uint8_t jf) { program.push_back({SocketFilterInstruction::JUMP_IF_EQUAL, jt, jf, value}); };
+        auto returnWith = [&program](uint32_t value) { program.push_back({SocketFilterInstruction::RETURN, 0, 0, value}); };
+        // Datagrams that are no Envelopes starting with their dataType are passed to user space once.
+        const uint32_t OTHER{(0 == shard) ? static_cast<uint32_t>(SocketFilterInstruction::ACCEPT) : static_cast<uint32_t>(SocketFilterInstruction::DROP)};
+
+        loadByte(0);
+        jumpIfEqual(0x0D, 1, 0);
+        returnWith(OTHER);
+        loadByte(1);
+        if (SHARDED) {
+            // Fragments of one message are kept together by sharding them by their sender's port.
+            jumpIfEqual(0xA4, 7, 0);
+            jumpIfEqual(0xA5, 1, 0);
+            returnWith(OTHER);
+            emit(SocketFilterInstruction::LOAD_HALFWORD_ABSOLUTE, 0);
+            emit(SocketFilterInstruction::MODULO, numberOfShards);
+            jumpIfEqual(shard, 0, 1);
+            returnWith(SocketFilterInstruction::ACCEPT);
+            returnWith(SocketFilterInstruction::DROP);
+        } else {
+            jumpIfEqual(0xA4, 1, 0);
+            returnWith(OTHER);
+        }
+        loadByte(OD4_HEADER_SIZE);
+        jumpIfEqual(DATATYPE_KEY, 1, 0);
+        returnWith(OTHER);
+
+        if (SHARDED) {
+            // shard = ((first byte >> 1) + 7 * second byte) % numberOfShards; shifting out the ZigZag sign
+            // spreads consecutive dataTypes over the shards. The second byte is either part of the dataType
+            // or the key of the following field and hence, the same for the same dataType.
+            loadByte(OD4_HEADER_SIZE + 1);
+            emit(SocketFilterInstruction::SHIFT_RIGHT, 1);
+            emit(SocketFilterInstruction::COPY_A_TO_X, 0);
+            loadByte(OD4_HEADER_SIZE + 2);
+            emit(SocketFilterInstruction::MULTIPLY, 7);
+            emit(SocketFilterInstruction::ADD_X, 0);
+            emit(SocketFilterInstruction::MODULO, numberOfShards);
+            jumpIfEqual(shard, 1, 0);
+            returnWith(SocketFilterInstruction::DROP);
+        }
+
+        if (!filterDataTypes) {
+            returnWith(SocketFilterInstruction::ACCEPT);
+        } else {
+            for (const int32_t dataType : dataTypes) {
+                // dataType is encoded as ZigZag varint (cf. ToProtoVisitor); the last byte has no continuation bit.
+                uint32_t value{(static_cast<uint32_t>(dataType) << 1) ^ static_cast<uint32_t>(dataType >> 31)};
+                std::vector<uint8_t> varint;
+                do {
+                    varint.push_back(static_cast<uint8_t>((value & 0x7F) | ((value > 0x7F) ? 0x80 : 0x00)));
+                    value >>= 7;
+                } while (0 < value);
+
+                // Each byte is compared with a load and a jump; a mismatch skips to the next dataType.
+                const std::size_t BLOCK_SIZE{2 * varint.size() + 1};
+                for (std::size_t i{0}; i < varint.size(); i++) {
+                    loadByte(OD4_HEADER_SIZE + 1 + static_cast<uint32_t>(i));
+                    jumpIfEqual(varint[i], 0, static_cast<uint8_t>(BLOCK_SIZE - 2 * (i + 1)));
+                }
+                returnWith(SocketFilterInstruction::ACCEPT);
+            }
+            returnWith(SocketFilterInstruction::DROP);
+        }
+
+        if (SocketFilterInstruction::MAX_INSTRUCTIONS < program.size()) {
+            program.clear();
+        }
+    } catch (...) { program.clear(); } // LCOV_EXCL_LINE
+    return program;
+}
+} // namespace cluon
@@ -8,6 +8,7 @@
 
 #include "cluon/TCPConnection.hpp"
 #include "cluon/IPv4Tools.hpp"
+#include "cluon/Reactor.hpp"
 #include "cluon/TerminateHandler.hpp"
 
 // clang-format off
@@ -15,10 +16,6 @@
     #include <errno.h>
     #include <iostream>
 #else
-    #ifdef __linux__
-        #include <linux/sockios.h>
-    #endif
-
     #include <arpa/inet.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
@@ -109,6 +106,10 @@ TCPConnection::~TCPConnection() noexcept {
     {
         m_readFromSocketThreadRunning.store(false);
 
+        if (m_isRegisteredWithReactor.load()) {
+            Reactor::instance().remove(m_socket);
+        }
+
         // Joining the thread could fail.
         try {
             if (m_readFromSocketThread.joinable()) {
@@ -148,31 +149,75 @@ void TCPConnection::closeSocket(int errorCode) noexcept {
 }
 
 void TCPConnection::startReadingFromSocket() noexcept {
-    // Constructing a thread could fail.
     try {
-        m_readFromSocketThread = std::thread(&TCPConnection::readFromSocket, this);
+        // Create buffer to store data from socket.
+        constexpr uint16_t MAX_LENGTH{65535};
+        m_buffer.resize(MAX_LENGTH);
 
-        // Let the operating system spawn the thread.
-        using namespace std::literals::chrono_literals;
-        do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
-    } catch (...) {          // LCOV_EXCL_LINE
-        closeSocket(ECHILD); // LCOV_EXCL_LINE
-    }
-
-    try {
+        // Only the thread reading from the socket adds entries; thus, use the ring buffer that only locks to wake the waiting pipeline thread.
         m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(
-            [this](PipelineEntry &&entry) { this->m_newDataDelegate(std::move(entry.m_data), std::move(entry.m_sampleTime)); });
+            [this](PipelineEntry &&entry) {
+                this->m_newDataDelegate(std::move(entry.m_data), std::move(entry.m_sampleTime));
+
+                // Pairs with pausing: either we see the paused socket or the event loop sees the room we made.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (this->m_isPaused.load(std::memory_order_relaxed)) {
+                    try {
+                        std::lock_guard<std::mutex> lck(this->m_pendingEntryMutex);
+                        this->resumeReadingIfDrained();
+                    } catch (...) {} // LCOV_EXCL_LINE
+                }
+            },
+            QUEUE_CAPACITY,
+            cluon::FullQueuePolicy::BLOCK);
         if (m_pipeline) {
             // Let the operating system spawn the thread.
             using namespace std::literals::chrono_literals; // NOLINT
             do { std::this_thread::sleep_for(1ms); } while (!m_pipeline->isRunning());
         }
     } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
+
+    if (!(m_socket < 0)) {
+        // Prefer the shared event loop; fall back to a thread polling the socket.
+        if (Reactor::instance().isRunning()) {
+            m_usesReactor = true;
+            m_readFromSocketThreadRunning.store(true);
+
+            // Data is only read from the socket once a newDataDelegate is set.
+            std::lock_guard<std::mutex> lck(m_newDataDelegateMutex);
+            if (nullptr != m_newDataDelegate) {
+                registerWithReactor();
+            }
+        } else {
+            // Constructing a thread could fail.
+            try {
+                m_readFromSocketThread = std::thread(&TCPConnection::readFromSocket, this);
+
+                // Let the operating system spawn the thread.
+                using namespace std::literals::chrono_literals;
+                do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
+            } catch (...) {          // LCOV_EXCL_LINE
+                closeSocket(ECHILD); // LCOV_EXCL_LINE
+            }
+        }
+    }
+}
+
+void TCPConnection::registerWithReactor() noexcept {
+    if (!m_isRegisteredWithReactor.exchange(true)) {
+        if (!Reactor::instance().add(m_socket, [this]() { this->readData(); })) {
+            m_isRegisteredWithReactor.store(false); // LCOV_EXCL_LINE
+            m_readFromSocketThreadRunning.store(false); // LCOV_EXCL_LINE
+        }
+    }
 }
 
 void TCPConnection::setOnNewData(std::function<void(std::string &&, std::chrono::system_clock::time_point &&)> newDataDelegate) noexcept {
     std::lock_guard<std::mutex> lck(m_newDataDelegateMutex);
     m_newDataDelegate = newDataDelegate;
+    if (m_usesReactor && m_readFromSocketThreadRunning.load() && (nullptr != m_newDataDelegate)) {
+        registerWithReactor();
+    }
 }
 
 void TCPConnection::setOnConnectionLost(std::function<void()> connectionLostDelegate) noexcept {
@@ -212,10 +257,6 @@ std::pair<ssize_t, int32_t> TCPConnection::send(std::string &&data) const noexce
 }
 
 void TCPConnection::readFromSocket() noexcept {
-    // Create buffer to store data from socket.
-    constexpr uint16_t MAX_LENGTH{65535};
-    std::array<char, MAX_LENGTH> buffer{};
-
     struct timeval timeout {};
 
     // Define file descriptor set to watch for read operations.
@@ -244,42 +285,84 @@ void TCPConnection::readFromSocket() noexcept {
             hasNewDataDelegate = (nullptr != m_newDataDelegate);
         }
         if (FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom) && hasNewDataDelegate) {
-            ssize_t bytesRead = ::recv(m_socket, buffer.data(), buffer.max_size(), 0);
-            if (0 >= bytesRead) {
-                // 0 == bytesRead: peer shut down the connection; 0 > bytesRead: other error.
-                m_readFromSocketThreadRunning.store(false);
-
-                {
-                    std::lock_guard<std::mutex> lck(m_connectionLostDelegateMutex);
-                    if (nullptr != m_connectionLostDelegate) {
-                        m_connectionLostDelegate();
-                    }
-                }
+            if (!readData()) {
                 break;
             }
+        }
+    }
+}
+
+bool TCPConnection::readData() noexcept {
+    int flags{0};
+#ifdef __linux__
+    // The shared event loop must never block.
+    flags = MSG_DONTWAIT;
+#endif
+    ssize_t bytesRead = ::recv(m_socket, m_buffer.data(), m_buffer.size(), flags);
+#ifndef WIN32
+    if ((0 > bytesRead) && (EAGAIN == errno)) {
+        return true; // LCOV_EXCL_LINE
+    }
+#endif
+    if (0 >= bytesRead) {
+        // 0 == bytesRead: peer shut down the connection; 0 > bytesRead: other error.
+        m_readFromSocketThreadRunning.store(false);
+
+        if (m_isRegisteredWithReactor.exchange(false)) {
+            Reactor::instance().remove(m_socket);
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(m_connectionLostDelegateMutex);
+            if (nullptr != m_connectionLostDelegate) {
+                m_connectionLostDelegate();
+            }
+        }
+        return false;
+    }
 
+    {
+        std::lock_guard<std::mutex> lck(m_newDataDelegateMutex);
+        if ((0 < bytesRead) && (nullptr != m_newDataDelegate)) {
+            // SIOCGSTAMP is not available for a stream-based socket,
+            // thus, falling back to regular chrono timestamping.
+            std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
             {
-                std::lock_guard<std::mutex> lck(m_newDataDelegateMutex);
-                if ((0 < bytesRead) && (nullptr != m_newDataDelegate)) {
-                    // SIOCGSTAMP is not available for a stream-based socket,
-                    // thus, falling back to regular chrono timestamping.
-                    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
-                    {
-                        PipelineEntry pe;
-                        pe.m_data       = std::string(buffer.data(), static_cast<size_t>(bytesRead));
-                        pe.m_sampleTime = timestamp;
-
-                        // Store entry in queue.
-                        if (m_pipeline) {
-                            m_pipeline->add(std::move(pe));
-                        }
-                    }
-
-                    if (m_pipeline) {
-                        m_pipeline->notifyAll();
-                    }
+                PipelineEntry pe;
+                pe.m_data       = std::string(m_buffer.data(), static_cast<size_t>(bytesRead));
+                pe.m_sampleTime = timestamp;
+
+                // Store entry in queue; the event loop must not block, so it pauses the socket while the queue is full.
+                if (m_pipeline && !m_usesReactor) {
+                    m_pipeline->add(std::move(pe));
+                } else if (m_pipeline && !m_pipeline->tryAdd(std::move(pe))) {
+                    try {
+                        std::lock_guard<std::mutex> lckPending(m_pendingEntryMutex);
+                        m_pendingEntry = std::move(pe);
+                        m_isPaused.store(true);
+                        Reactor::instance().pause(m_socket);
+
+                        // The delegate could have made room before noticing the pause.
+                        resumeReadingIfDrained();
+                    } catch (...) {} // LCOV_EXCL_LINE
                 }
             }
+
+            if (m_pipeline) {
+                m_pipeline->notifyAll();
+            }
+        }
+    }
+    return true;
+}
+
+void TCPConnection::resumeReadingIfDrained() noexcept {
+    if (m_isPaused.load() && (m_pipeline->size() <= QUEUE_CAPACITY / 2)) {
+        // The event loop does not add entries while paused; thus, we are the only producer here.
+        if (m_pipeline->tryAdd(std::move(m_pendingEntry))) {
+            m_pipeline->notifyAll();
+            m_isPaused.store(false);
+            Reactor::instance().resume(m_socket);
         }
     }
 }
@@ -7,6 +7,7 @@
  */
 
 #include "cluon/TCPServer.hpp"
+#include "cluon/Reactor.hpp"
 #include "cluon/TerminateHandler.hpp"
 
 // clang-format off
@@ -15,6 +16,7 @@
     #include <iostream>
 #else
     #include <arpa/inet.h>
+    #include <fcntl.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
     #include <sys/types.h>
@@ -78,15 +80,28 @@ TCPServer::TCPServer(uint16_t port, std::function<void(std::string &&from, std::
                 constexpr int32_t MAX_PENDING_CONNECTIONS{100};
                 retVal = ::listen(m_socket, MAX_PENDING_CONNECTIONS);
                 if (-1 != retVal) {
-                    // Constructing a thread could fail.
-                    try {
-                        m_readFromSocketThread = std::thread(&TCPServer::readFromSocket, this);
-
-                        // Let the operating system spawn the thread.
-                        using namespace std::literals::chrono_literals;
-                        do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
-                    } catch (...) {          // LCOV_EXCL_LINE
-                        closeSocket(ECHILD); // LCOV_EXCL_LINE
+#ifndef WIN32
+                    // The shared event loop must never block in accept.
+                    const int FLAGS{::fcntl(m_socket, F_GETFL, 0)};
+                    const bool IS_NONBLOCKING{0 == ::fcntl(m_socket, F_SETFL, FLAGS | O_NONBLOCK)};
+#else
+                    const bool IS_NONBLOCKING{false};
+#endif
+                    // Prefer the shared event loop; fall back to a thread polling the socket.
+                    if (IS_NONBLOCKING && Reactor::instance().add(m_socket, [this]() { this->acceptConnection(); })) {
+                        m_isRegisteredWithReactor = true;
+                        m_readFromSocketThreadRunning.store(true);
+                    } else {
+                        // Constructing a thread could fail.
+                        try {
+                            m_readFromSocketThread = std::thread(&TCPServer::readFromSocket, this);
+
+                            // Let the operating system spawn the thread.
+                            using namespace std::literals::chrono_literals;
+                            do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
+                        } catch (...) {          // LCOV_EXCL_LINE
+                            closeSocket(ECHILD); // LCOV_EXCL_LINE
+                        }
                     }
                 } else { // LCOV_EXCL_LINE
 #ifdef WIN32             // LCOV_EXCL_LINE
@@ -111,6 +126,10 @@ TCPServer::TCPServer(uint16_t port, std::function<void(std::string &&from, std::
 TCPServer::~TCPServer() noexcept {
     m_readFromSocketThreadRunning.store(false);
 
+    if (m_isRegisteredWithReactor) {
+        Reactor::instance().remove(m_socket);
+    }
+
     // Joining the thread could fail.
     try {
         if (m_readFromSocketThread.joinable()) {
@@ -158,9 +177,6 @@ void TCPServer::readFromSocket() noexcept {
     // Indicate to main thread that we are ready.
     m_readFromSocketThreadRunning.store(true);
 
-    constexpr uint16_t MAX_ADDR_SIZE{1024};
-    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
-
     while (m_readFromSocketThreadRunning.load()) {
         // Define timeout for select system call. The timeval struct must be
         // reinitialized for every select call as it might be modified containing
@@ -172,19 +188,26 @@ void TCPServer::readFromSocket() noexcept {
         FD_SET(m_socket, &setOfFiledescriptorsToReadFrom);
         ::select(m_socket + 1, &setOfFiledescriptorsToReadFrom, nullptr, nullptr, &timeout);
         if (FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom)) {
-            struct sockaddr_storage remote;
-            socklen_t addrLength     = sizeof(remote);
-            int32_t connectingClient = ::accept(m_socket, reinterpret_cast<struct sockaddr *>(&remote), &addrLength);
-            if ((0 <= connectingClient) && (nullptr != m_newConnectionDelegate)) {
-                ::inet_ntop(remote.ss_family,
-                            &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
-                            remoteAddress.data(),
-                            remoteAddress.max_size());
-                const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)}; // NOLINT
-                m_newConnectionDelegate(std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT),
-                                        std::shared_ptr<cluon::TCPConnection>(new cluon::TCPConnection(connectingClient)));
-            }
+            acceptConnection();
         }
     }
 }
+
+void TCPServer::acceptConnection() noexcept {
+    constexpr uint16_t MAX_ADDR_SIZE{1024};
+    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
+
+    struct sockaddr_storage remote;
+    socklen_t addrLength     = sizeof(remote);
+    int32_t connectingClient = ::accept(m_socket, reinterpret_cast<struct sockaddr *>(&remote), &addrLength);
+    if ((0 <= connectingClient) && (nullptr != m_newConnectionDelegate)) {
+        ::inet_ntop(remote.ss_family,
+                    &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
+                    remoteAddress.data(),
+                    remoteAddress.max_size());
+        const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)}; // NOLINT
+        m_newConnectionDelegate(std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT),
+                                std::shared_ptr<cluon::TCPConnection>(new cluon::TCPConnection(connectingClient)));
+    }
+}
 } // namespace cluon
@@ -12,11 +12,25 @@
 
 namespace cluon {
 
+ToProtoVisitor::ToProtoVisitor(std::string &buffer) noexcept
+    : m_buffer{&buffer}
+    , m_start{buffer.size()} {}
+
 std::string ToProtoVisitor::encodedData() const noexcept {
-    std::string s{m_buffer.str()};
+    std::string s{m_buffer->substr(m_start)};
     return s;
 }
 
+std::size_t ToProtoVisitor::encodedSize() const noexcept {
+    return m_buffer->size() - m_start;
+}
+
+void ToProtoVisitor::reset() noexcept {
+    m_buffer->resize(m_start);
+    m_nestedSizes.clear();
+    m_nestedSizesIndex = 0;
+}
+
 void ToProtoVisitor::preVisit(int32_t id, const std::string &shortName, const std::string &longName) noexcept {
     (void)id;
     (void)shortName;
@@ -90,94 +104,94 @@ void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&na
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::FOUR_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(*m_buffer, key);
+    encode(*m_buffer, v);
 }
 
 void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, double &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::EIGHT_BYTES));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(*m_buffer, key);
+    encode(*m_buffer, v);
 }
 
 void ToProtoVisitor::visit(uint32_t id, std::string &&typeName, std::string &&name, std::string &v) noexcept {
     (void)typeName;
     (void)name;
     uint64_t key = encodeKey(id, static_cast<uint8_t>(ProtoConstants::LENGTH_DELIMITED));
-    toVarInt(m_buffer, key);
-    encode(m_buffer, v);
+    toVarInt(*m_buffer, key);
+    encode(*m_buffer, v);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, bool &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, bool &v) noexcept {
     uint64_t _v{(v ? 1u : 0u)};
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, int8_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, int8_t &v) noexcept {
     uint64_t _v = toZigZag8(v);
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, uint8_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, uint8_t &v) noexcept {
     uint64_t _v = v;
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, int16_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, int16_t &v) noexcept {
     uint64_t _v = toZigZag16(v);
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, uint16_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, uint16_t &v) noexcept {
     uint64_t _v = v;
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, int32_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, int32_t &v) noexcept {
     uint64_t _v = toZigZag32(v);
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, uint32_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, uint32_t &v) noexcept {
     uint64_t _v = v;
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, int64_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, int64_t &v) noexcept {
     uint64_t _v = toZigZag64(v);
     return toVarInt(o, _v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, uint64_t &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, uint64_t &v) noexcept {
     return toVarInt(o, v);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, float &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, float &v) noexcept {
     // Store 4 bytes as little endian encoding.
     uint32_t _v{0};
     std::memmove(&_v, &v, sizeof(float));
     _v = htole32(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
+    o.append(reinterpret_cast<const char *>(&_v), sizeof(uint32_t)); // NOLINT
     return sizeof(uint32_t);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, double &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, double &v) noexcept {
     // Store 8 bytes as little endian encoding.
     uint64_t _v{0};
     std::memmove(&_v, &v, sizeof(double));
     _v = htole64(_v);
-    o.write(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
+    o.append(reinterpret_cast<const char *>(&_v), sizeof(uint64_t)); // NOLINT
     return sizeof(uint64_t);
 }
 
-std::size_t ToProtoVisitor::encode(std::ostream &o, const std::string &v) noexcept {
+std::size_t ToProtoVisitor::encode(std::string &o, const std::string &v) noexcept {
     const std::size_t LENGTH = v.length();
     std::size_t size         = toVarInt(o, LENGTH);
-    o.write(v.c_str(), static_cast<std::streamsize>(LENGTH)); // LENGTH won't be negative.
+    o.append(v.data(), LENGTH);
     return size + LENGTH;
 }
 
@@ -201,20 +215,20 @@ uint64_t ToProtoVisitor::encodeKey(uint32_t fieldIdentifier, uint8_t protoType)
     return (fieldIdentifier << 0x3) | protoType;
 }
 
-std::size_t ToProtoVisitor::toVarInt(std::ostream &out, uint64_t v) noexcept {
+std::size_t ToProtoVisitor::toVarInt(std::string &out, uint64_t v) noexcept {
     // Minimum size is of the encoded data.
     std::size_t size{1};
     uint8_t b{0};
     while (0x7f < v) {
         // Use the MSB to indicate value overflow for more bytes to come.
         b = (static_cast<uint8_t>(v & 0x7f)) | 0x80;
-        out.put(static_cast<char>(b));
+        out.push_back(static_cast<char>(b));
         v >>= 7;
         size++;
     }
     // Write final byte.
     b = (static_cast<uint8_t>(v)) & 0x7f;
-    out.put(static_cast<char>(b));
+    out.push_back(static_cast<char>(b));
 
     return size;
 }
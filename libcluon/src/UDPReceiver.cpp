@@ -8,6 +8,7 @@
 
 #include "cluon/UDPReceiver.hpp"
 #include "cluon/IPv4Tools.hpp"
+#include "cluon/Reactor.hpp"
 #include "cluon/TerminateHandler.hpp"
 #include "cluon/UDPPacketSizeConstraints.hpp"
 
@@ -22,10 +23,6 @@
 
     #include <iostream>
 #else
-    #ifdef __linux__
-        #include <linux/sockios.h>
-    #endif
-
     #include <arpa/inet.h>
     #include <fcntl.h>
     #include <sys/ioctl.h>
@@ -38,6 +35,12 @@
     #include <ifaddrs.h>
     #include <netdb.h>
 #endif
+
+#ifdef __linux__
+    #include <linux/filter.h>
+    #include <linux/net_tstamp.h>
+    #include <netinet/udp.h>
+#endif
 // clang-format on
 
 #include <cstring>
@@ -54,12 +57,36 @@ namespace cluon {
 UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
                          uint16_t receiveFromPort,
                          std::function<void(std::string &&, std::string &&, std::chrono::system_clock::time_point &&)> delegate,
-                         uint16_t localSendFromPort) noexcept
+                         uint16_t localSendFromPort,
+                         std::size_t numberOfWorkers,
+                         std::function<std::size_t(const ReceiveBuffer &, uint64_t)> orderingKey,
+                         std::size_t queueCapacity) noexcept
+    : UDPReceiver(receiveFromAddress,
+                  receiveFromPort,
+                  (nullptr == delegate) ? std::function<void(ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&)>(nullptr)
+                                        : [delegate](ReceiveBuffer &&data, uint64_t sender, std::chrono::system_clock::time_point &&timestamp) {
+                                              // Compatibility with the delegate taking strings.
+                                              delegate(data.toString(), decodeSenderAddress(sender), std::move(timestamp));
+                                          },
+                  localSendFromPort,
+                  numberOfWorkers,
+                  orderingKey,
+                  queueCapacity) {}
+
+UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
+                         uint16_t receiveFromPort,
+                         std::function<void(ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&)> delegate,
+                         uint16_t localSendFromPort,
+                         std::size_t numberOfWorkers,
+                         std::function<std::size_t(const ReceiveBuffer &, uint64_t)> orderingKey,
+                         std::size_t queueCapacity,
+                         const std::vector<SocketFilterInstruction> &socketFilter) noexcept
     : m_localSendFromPort(localSendFromPort)
     , m_receiveFromAddress()
     , m_mreq()
     , m_readFromSocketThread()
-    , m_delegate(std::move(delegate)) {
+    , m_delegate(std::move(delegate))
+    , m_queueCapacity(queueCapacity) {
     // Decompose given address string to check validity with numerical IPv4 address.
     std::string tmp{cluon::getIPv4FromHostname(receiveFromAddress)};
     std::replace(tmp.begin(), tmp.end(), '.', ' ');
@@ -163,6 +190,20 @@ UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
             }
         }
 
+#ifdef SO_REUSEPORT
+        if (!(m_socket < 0) && m_isMulticast) {
+            // Allow several sockets on the same group and port to share the load, e.g., using
+            // socket filters, as multicast datagrams are delivered to each of them.
+            uint32_t YES = 1;
+            // clang-format off
+            auto retVal = ::setsockopt(m_socket, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char *>(&YES), sizeof(YES)); // NOLINT
+            // clang-format on
+            if (0 > retVal) {
+                std::cerr << "[cluon::UDPReceiver] Error while trying to set SO_REUSEPORT: " << errno << std::endl; // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
 #ifndef WIN32
         if (!(m_socket < 0) && isBroadcast) {
             // Enabling broadcast.
@@ -217,6 +258,31 @@ UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
             }
         }
 
+#ifdef __linux__
+        if (!(m_socket < 0)) {
+            // Let the kernel deliver a receive time stamp with each datagram.
+            if (!setTimeStampMode(ReceiveTimeStampMode::SOFTWARE)) {
+                std::cerr << "[cluon::UDPReceiver] Error while trying to set SO_TIMESTAMPNS: " << errno << std::endl; // LCOV_EXCL_LINE
+            }
+        }
+#endif
+
+#if defined(__linux__) && defined(UDP_GRO)
+        if (!(m_socket < 0) && socketFilter.empty()) {
+            // Let the kernel coalesce datagrams of equal size (generic receive offload); they are split in readDatagrams.
+            // Older kernels do not support this option and deliver every datagram separately.
+            int YES = 1;
+            m_hasReceiveOffload = (0 == ::setsockopt(m_socket, IPPROTO_UDP, UDP_GRO, &YES, sizeof(YES)));
+        }
+#endif
+
+        if (!(m_socket < 0) && !socketFilter.empty()) {
+            // Attach the filter before binding; otherwise, datagrams could be queued that did not pass it.
+            if (!setSocketFilter(socketFilter)) {
+                std::cerr << "[cluon::UDPReceiver] Error while trying to attach socket filter: " << errno << std::endl;
+            }
+        }
+
         if (!(m_socket < 0)) {
             // Bind to receive address/port.
             // clang-format off
@@ -254,6 +320,7 @@ UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
 
         // Fill list of local IP address to avoid sending data to ourselves.
         if (!(m_socket < 0)) {
+            std::vector<uint32_t> localIPAddresses;
 #ifdef WIN32
             DWORD size{0};
             if (ERROR_BUFFER_OVERFLOW == GetAdaptersAddresses(AF_UNSPEC, GAA_FLAG_INCLUDE_PREFIX, NULL, NULL, &size)) {
@@ -265,8 +332,7 @@ UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
                             if (AF_INET == unicastAddress->Address.lpSockaddr->sa_family) {
                                 ::getnameinfo(unicastAddress->Address.lpSockaddr, unicastAddress->Address.iSockaddrLength, nullptr, 0, NULL, 0, NI_NUMERICHOST);
                                 std::memcpy(&tmpSocketAddress, unicastAddress->Address.lpSockaddr, sizeof(tmpSocketAddress)); /* Flawfinder: ignore */ // NOLINT
-                                const unsigned long LOCAL_IP = tmpSocketAddress.sin_addr.s_addr;
-                                m_listOfLocalIPAddresses.insert(LOCAL_IP);
+                                localIPAddresses.push_back(static_cast<uint32_t>(tmpSocketAddress.sin_addr.s_addr));
                             }
                         }
                     }
@@ -280,36 +346,83 @@ UDPReceiver::UDPReceiver(const std::string &receiveFromAddress,
                     if ((nullptr != it->ifa_addr) && (it->ifa_addr->sa_family == AF_INET)) {
                         if (0 == ::getnameinfo(it->ifa_addr, sizeof(struct sockaddr_in), nullptr, 0, nullptr, 0, NI_NUMERICHOST)) {
                             std::memcpy(&tmpSocketAddress, it->ifa_addr, sizeof(tmpSocketAddress)); /* Flawfinder: ignore */ // NOLINT
-                            const unsigned long LOCAL_IP = tmpSocketAddress.sin_addr.s_addr;
-                            m_listOfLocalIPAddresses.insert(LOCAL_IP);
+                            localIPAddresses.push_back(static_cast<uint32_t>(tmpSocketAddress.sin_addr.s_addr));
                         }
                     }
                 }
                 ::freeifaddrs(interfaceAddress);
             }
 #endif
+            setLocalIPAddresses(localIPAddresses);
         }
 
         if (!(m_socket < 0)) {
-            // Constructing the receiving thread could fail.
             try {
-                m_readFromSocketThread = std::thread(&UDPReceiver::readFromSocket, this);
-
-                // Let the operating system spawn the thread.
-                using namespace std::literals::chrono_literals; // NOLINT
-                do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
-            } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
-
-            try {
-                m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(
-                    [this](PipelineEntry &&entry) { this->m_delegate(std::move(entry.m_data), std::move(entry.m_from), std::move(entry.m_sampleTime)); });
+                // Received bytes are stored in pooled slabs that are recycled once the delegate has consumed them;
+                // keep enough small slabs for full queues but only as many large ones as needed to receive.
+                const std::size_t MAX_QUEUED_DATAGRAMS{(0 < queueCapacity) ? queueCapacity * std::max<std::size_t>(numberOfWorkers, 1)
+                                                                           : 4 * MAX_DATAGRAMS_PER_RECEIVE};
+                m_receiveBufferPool      = std::make_shared<ReceiveBufferPool>(MAX_DATAGRAM_LENGTH, 2 * MAX_DATAGRAMS_PER_RECEIVE);
+                m_smallReceiveBufferPool = std::make_shared<ReceiveBufferPool>(SMALL_DATAGRAM_LENGTH, MAX_QUEUED_DATAGRAMS + MAX_DATAGRAMS_PER_RECEIVE);
+
+                // Only the thread reading from the socket adds entries; thus, use the ring buffer that only locks to wake the waiting pipeline thread unless unbounded.
+                auto delegateForEntry = [this](PipelineEntry &&entry) {
+                    if (this->m_deliveryLatency.isEnabled()) {
+                        this->m_deliveryLatency.record(std::chrono::system_clock::now() - entry.m_sampleTime);
+                    }
+                    this->m_delegate(std::move(entry.m_data), std::move(entry.m_from), std::move(entry.m_sampleTime));
+
+                    // Pairs with pausing: either we see the paused socket or the event loop sees the room we made.
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (this->m_isPaused.load(std::memory_order_relaxed)) {
+                        try {
+                            std::lock_guard<std::mutex> lck(this->m_backlogMutex);
+                            this->resumeReadingIfDrained();
+                        } catch (...) {} // LCOV_EXCL_LINE
+                    }
+                };
+                if (1 < numberOfWorkers) {
+                    auto orderingKeyForEntry = [orderingKey](const PipelineEntry &entry) {
+                        return (nullptr != orderingKey) ? orderingKey(entry.m_data, entry.m_from) : static_cast<std::size_t>(entry.m_from);
+                    };
+                    m_pipelinePool = std::make_shared<cluon::NotifyingPipelinePool<PipelineEntry>>(
+                        numberOfWorkers, orderingKeyForEntry, delegateForEntry, queueCapacity, cluon::FullQueuePolicy::BLOCK);
+                } else if (0 < queueCapacity) {
+                    m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(delegateForEntry, queueCapacity, cluon::FullQueuePolicy::BLOCK);
+                } else {
+                    m_pipeline = std::make_shared<cluon::NotifyingPipeline<PipelineEntry>>(delegateForEntry);
+                }
                 if (m_pipeline) {
                     // Let the operating system spawn the thread.
                     using namespace std::literals::chrono_literals; // NOLINT
                     do { std::this_thread::sleep_for(1ms); } while (!m_pipeline->isRunning());
                 }
+                if (m_pipelinePool) {
+                    // Let the operating system spawn the threads.
+                    using namespace std::literals::chrono_literals; // NOLINT
+                    do { std::this_thread::sleep_for(1ms); } while (!m_pipelinePool->isRunning());
+                }
             } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
         }
+
+        if (!(m_socket < 0)) {
+            // Prefer the shared event loop; fall back to a thread polling the socket.
+            m_isRegisteredWithReactor = true;
+            if (Reactor::instance().add(m_socket, [this]() { this->readDatagrams(); })) {
+                m_readFromSocketThreadRunning.store(true);
+            } else {
+                m_isRegisteredWithReactor = false;
+
+                // Constructing the receiving thread could fail.
+                try {
+                    m_readFromSocketThread = std::thread(&UDPReceiver::readFromSocket, this);
+
+                    // Let the operating system spawn the thread.
+                    using namespace std::literals::chrono_literals; // NOLINT
+                    do { std::this_thread::sleep_for(1ms); } while (!m_readFromSocketThreadRunning.load());
+                } catch (...) { closeSocket(ECHILD); } // LCOV_EXCL_LINE
+            }
+        }
     }
 }
 
@@ -317,6 +430,10 @@ UDPReceiver::~UDPReceiver() noexcept {
     {
         m_readFromSocketThreadRunning.store(false);
 
+        if (m_isRegisteredWithReactor) {
+            Reactor::instance().remove(m_socket);
+        }
+
         // Joining the thread could fail.
         try {
             if (m_readFromSocketThread.joinable()) {
@@ -326,6 +443,7 @@ UDPReceiver::~UDPReceiver() noexcept {
     }
 
     m_pipeline.reset();
+    m_pipelinePool.reset();
 
     closeSocket(0);
 }
@@ -366,25 +484,194 @@ bool UDPReceiver::isRunning() const noexcept {
     return (m_readFromSocketThreadRunning.load() && !TerminateHandler::instance().isTerminated.load());
 }
 
-void UDPReceiver::readFromSocket() noexcept {
-    // Create buffer to store data from socket.
-    constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
-                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
-                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
-    std::array<char, MAX_LENGTH> buffer{};
+bool UDPReceiver::hasReceiveOffload() const noexcept {
+    return m_hasReceiveOffload;
+}
+
+bool UDPReceiver::setSocketFilter(const std::vector<SocketFilterInstruction> &program) noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    static_assert(sizeof(SocketFilterInstruction) == sizeof(struct sock_filter), "SocketFilterInstruction must match struct sock_filter.");
+    if (!(m_socket < 0)) {
+        if (program.empty()) {
+            int unused{0};
+            retVal = (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_DETACH_FILTER, &unused, sizeof(unused))) || (ENOENT == errno);
+#ifdef UDP_GRO
+            if (retVal) {
+                int YES = 1;
+                m_hasReceiveOffload = (0 == ::setsockopt(m_socket, IPPROTO_UDP, UDP_GRO, &YES, sizeof(YES)));
+            }
+#endif
+        } else if (SocketFilterInstruction::MAX_INSTRUCTIONS >= program.size()) {
+#ifdef UDP_GRO
+            // A filter only sees the first of coalesced datagrams; thus, let the kernel deliver every datagram separately.
+            if (m_hasReceiveOffload) {
+                int NO = 0;
+                m_hasReceiveOffload = (0 != ::setsockopt(m_socket, IPPROTO_UDP, UDP_GRO, &NO, sizeof(NO)));
+            }
+#endif
+            if (!m_hasReceiveOffload) {
+                struct sock_fprog fprog {};
+                fprog.len    = static_cast<uint16_t>(program.size());
+                fprog.filter = reinterpret_cast<struct sock_filter *>(const_cast<SocketFilterInstruction *>(program.data())); // NOLINT
+                retVal       = (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)));
+            }
+        }
+    }
+#else
+    (void)program;
+#endif
+    return retVal;
+}
+
+bool UDPReceiver::setTimeStampMode(ReceiveTimeStampMode mode) noexcept {
+    bool retVal{false};
+#ifdef __linux__
+    if (!(m_socket < 0)) {
+        // Enable the new source first; both kinds of control messages are understood while switching.
+        int timestampNS{(ReceiveTimeStampMode::SOFTWARE == mode) ? 1 : 0};
+        int timestamping{(ReceiveTimeStampMode::HARDWARE == mode)
+                             ? (SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE | SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE)
+                             : 0};
+        if (ReceiveTimeStampMode::HARDWARE == mode) {
+            retVal = (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPING, &timestamping, sizeof(timestamping)))
+                     && (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &timestampNS, sizeof(timestampNS)));
+        } else {
+            retVal = (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &timestampNS, sizeof(timestampNS)))
+                     && (0 == ::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPING, &timestamping, sizeof(timestamping)));
+        }
+    }
+#else
+    retVal = (ReceiveTimeStampMode::USER_SPACE == mode);
+#endif
+    if (retVal) {
+        m_timeStampMode.store(mode);
+    }
+    return retVal;
+}
 
+ReceiveTimeStampMode UDPReceiver::timeStampMode() const noexcept {
+    return m_timeStampMode.load();
+}
+
+LatencyHistogram &UDPReceiver::deliveryLatency() noexcept {
+    return m_deliveryLatency;
+}
+
+void UDPReceiver::setLocalIPAddresses(const std::vector<uint32_t> &localIPAddresses) noexcept {
+    try {
+        uint32_t bits{1};
+        while ((static_cast<std::size_t>(1u) << bits) < 2 * localIPAddresses.size()) {
+            bits++;
+        }
+        m_localIPAddresses.assign(1u << bits, 0);
+        m_localIPAddressesShift = 32 - bits;
+
+        const std::size_t MASK{m_localIPAddresses.size() - 1};
+        for (const uint32_t ip : localIPAddresses) {
+            std::size_t slot{static_cast<std::size_t>((ip * 2654435761u) >> m_localIPAddressesShift)};
+            while ((0 != m_localIPAddresses[slot]) && (ip != m_localIPAddresses[slot])) {
+                slot = (slot + 1) & MASK;
+            }
+            m_localIPAddresses[slot] = ip;
+        }
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+bool UDPReceiver::isSentFromUs(const struct sockaddr_in &remote) const noexcept {
+    // Compare the port first as it rules out almost all datagrams from other senders.
+    if ((m_localSendFromPort != ntohs(remote.sin_port)) || m_localIPAddresses.empty()) {
+        return false;
+    }
+    const uint32_t IP{static_cast<uint32_t>(remote.sin_addr.s_addr)};
+    const std::size_t MASK{m_localIPAddresses.size() - 1};
+    std::size_t slot{static_cast<std::size_t>((IP * 2654435761u) >> m_localIPAddressesShift)};
+    while (0 != m_localIPAddresses[slot]) {
+        if (IP == m_localIPAddresses[slot]) {
+            return true;
+        }
+        slot = (slot + 1) & MASK;
+    }
+    return false;
+}
+
+void UDPReceiver::handleReceivedBytes(ReceiveBuffer &&data, const struct sockaddr_in &remote, std::chrono::system_clock::time_point &&timestamp) noexcept {
+    const uint16_t RECVFROM_PORT{ntohs(remote.sin_port)};
+
+    // Create a pipeline entry to be processed concurrently.
+    PipelineEntry pe;
+    pe.m_data       = std::move(data);
+    pe.m_from       = encodeSenderAddress(remote.sin_addr.s_addr, RECVFROM_PORT);
+    pe.m_sampleTime = timestamp;
+
+    // Store entry in queue; the event loop must not block, so entries not fitting wait in the backlog.
+    if (m_isRegisteredWithReactor) {
+        const bool ADDED{m_backlog.empty()
+                         && (m_pipeline ? m_pipeline->tryAdd(std::move(pe)) : (m_pipelinePool && m_pipelinePool->tryAdd(std::move(pe))))};
+        if (!ADDED) {
+            try {
+                m_backlog.emplace_back(std::move(pe));
+            } catch (...) {} // LCOV_EXCL_LINE
+        }
+    } else if (m_pipeline) {
+        m_pipeline->add(std::move(pe));
+    } else if (m_pipelinePool) {
+        m_pipelinePool->add(std::move(pe));
+    }
+}
+
+ReceiveBuffer UDPReceiver::toRightSizedBuffer(ReceiveBuffer &received) noexcept {
+    // Small datagrams are copied so that the large slab is kept for the next receive.
+    if (received.size() <= SMALL_DATAGRAM_LENGTH) {
+        ReceiveBuffer small{m_smallReceiveBufferPool->acquire()};
+        if (nullptr != small.data()) {
+            small.size(received.size());
+            std::memcpy(small.data(), received.data(), received.size()); /* Flawfinder: ignore */ // NOLINT
+            return small;
+        }
+    }
+    return std::move(received);
+}
+
+void UDPReceiver::pauseReading() noexcept {
+    try {
+        std::lock_guard<std::mutex> lck(m_backlogMutex);
+        m_isPaused.store(true);
+        Reactor::instance().pause(m_socket);
+
+        // The delegate could have made room before noticing the pause.
+        resumeReadingIfDrained();
+    } catch (...) {} // LCOV_EXCL_LINE
+}
+
+void UDPReceiver::resumeReadingIfDrained() noexcept {
+    const std::size_t QUEUE_SIZE{m_pipeline ? m_pipeline->size() : (m_pipelinePool ? m_pipelinePool->size() : 0)};
+    if (m_isPaused.load() && (QUEUE_SIZE <= m_queueCapacity / 2)) {
+        // The event loop does not add entries while paused; thus, we are the only producer here.
+        while (!m_backlog.empty()
+               && (m_pipeline ? m_pipeline->tryAdd(std::move(m_backlog.front()))
+                              : (m_pipelinePool && m_pipelinePool->tryAdd(std::move(m_backlog.front()))))) {
+            m_backlog.pop_front();
+        }
+        if (m_pipeline) {
+            m_pipeline->notifyAll();
+        }
+        if (m_pipelinePool) {
+            m_pipelinePool->notifyAll();
+        }
+        if (m_backlog.empty()) {
+            m_isPaused.store(false);
+            Reactor::instance().resume(m_socket);
+        }
+    }
+}
+
+void UDPReceiver::readFromSocket() noexcept {
     struct timeval timeout {};
 
     // Define file descriptor set to watch for read operations.
     fd_set setOfFiledescriptorsToReadFrom{};
 
-    // Sender address and port.
-    constexpr uint16_t MAX_ADDR_SIZE{1024};
-    std::array<char, MAX_ADDR_SIZE> remoteAddress{};
-
-    struct sockaddr_storage remote {};
-    socklen_t addrLength{sizeof(remote)};
-
     // Indicate to main thread that we are ready.
     m_readFromSocketThreadRunning.store(true);
 
@@ -399,72 +686,158 @@ void UDPReceiver::readFromSocket() noexcept {
         FD_SET(m_socket, &setOfFiledescriptorsToReadFrom); // NOLINT
         ::select(m_socket + 1, &setOfFiledescriptorsToReadFrom, nullptr, nullptr, &timeout);
 
-        ssize_t totalBytesRead{0};
         if (FD_ISSET(m_socket, &setOfFiledescriptorsToReadFrom)) { // NOLINT
-            ssize_t bytesRead{0};
-            do {
-                bytesRead = ::recvfrom(m_socket,
-                                       buffer.data(),
-                                       buffer.max_size(),
-                                       0,
-                                       reinterpret_cast<struct sockaddr *>(&remote), // NOLINT
-                                       reinterpret_cast<socklen_t *>(&addrLength));  // NOLINT
-
-                if ((0 < bytesRead) && (nullptr != m_delegate)) {
+            readDatagrams();
+        }
+    }
+}
+
+void UDPReceiver::readDatagrams() noexcept {
+    ssize_t totalBytesRead{0};
 #ifdef __linux__
-                    std::chrono::system_clock::time_point timestamp;
-                    struct timeval receivedTimeStamp {};
-                    if (0 == ::ioctl(m_socket, SIOCGSTAMP, &receivedTimeStamp)) { // NOLINT
-                        // Transform struct timeval to C++ chrono.
-                        std::chrono::time_point<std::chrono::system_clock, std::chrono::microseconds> transformedTimePoint(
-                            std::chrono::microseconds(receivedTimeStamp.tv_sec * 1000000L + receivedTimeStamp.tv_usec));
-                        timestamp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
-                    } else { // LCOV_EXCL_LINE
-                        // In case the ioctl failed, fall back to chrono. // LCOV_EXCL_LINE
-                        timestamp = std::chrono::system_clock::now(); // LCOV_EXCL_LINE
-                    }
-#else
-                    std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
-#endif
+    // Receive up to MAX_DATAGRAMS datagrams with one system call directly into
+    // pooled slabs; the kernel time stamps are delivered as control messages.
+    constexpr std::size_t MAX_DATAGRAMS{MAX_DATAGRAMS_PER_RECEIVE};
+    constexpr std::size_t CONTROL_LENGTH{CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(3 * sizeof(struct timespec)) + CMSG_SPACE(sizeof(int))};
+    std::array<char, MAX_DATAGRAMS * CONTROL_LENGTH> control{};
+    std::array<struct sockaddr_in, MAX_DATAGRAMS> remotes{};
+    std::array<struct iovec, MAX_DATAGRAMS> iovecs{};
+    std::array<struct mmsghdr, MAX_DATAGRAMS> messages{};
+
+    int numberOfMessages{0};
+    do {
+        std::size_t numberOfBuffers{0};
+        for (std::size_t i{0}; i < MAX_DATAGRAMS; i++, numberOfBuffers++) {
+            // Slabs that were handed over to the pipeline are replaced.
+            if (nullptr == m_receiveBuffers[i].data()) {
+                m_receiveBuffers[i] = m_receiveBufferPool->acquire();
+                if (nullptr == m_receiveBuffers[i].data()) {
+                    break; // LCOV_EXCL_LINE
+                }
+            }
+            iovecs[i].iov_base                 = m_receiveBuffers[i].data();
+            iovecs[i].iov_len                  = m_receiveBuffers[i].capacity();
+            messages[i].msg_hdr.msg_name       = &remotes[i];
+            messages[i].msg_hdr.msg_namelen    = sizeof(remotes[i]);
+            messages[i].msg_hdr.msg_iov        = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen     = 1;
+            messages[i].msg_hdr.msg_control    = &control[i * CONTROL_LENGTH];
+            messages[i].msg_hdr.msg_controllen = CONTROL_LENGTH;
+            messages[i].msg_hdr.msg_flags      = 0;
+            messages[i].msg_len                = 0;
+        }
+        if (0 == numberOfBuffers) {
+            break; // LCOV_EXCL_LINE
+        }
 
-                    // Transform sender address to C-string.
-                    ::inet_ntop(remote.ss_family,
-                                &((reinterpret_cast<struct sockaddr_in *>(&remote))->sin_addr), // NOLINT
-                                remoteAddress.data(),
-                                remoteAddress.max_size());
-                    const unsigned long RECVFROM_IP{reinterpret_cast<struct sockaddr_in *>(&remote)->sin_addr.s_addr}; // NOLINT
-                    const uint16_t RECVFROM_PORT{ntohs(reinterpret_cast<struct sockaddr_in *>(&remote)->sin_port)};    // NOLINT
-
-                    // Check if the bytes actually came from us.
-                    bool sentFromUs{false};
-                    {
-                        auto pos                   = m_listOfLocalIPAddresses.find(RECVFROM_IP);
-                        const bool sentFromLocalIP = (pos != m_listOfLocalIPAddresses.end() && (*pos == RECVFROM_IP));
-                        sentFromUs                 = sentFromLocalIP && (m_localSendFromPort == RECVFROM_PORT);
+        numberOfMessages = ::recvmmsg(m_socket, messages.data(), static_cast<unsigned int>(numberOfBuffers), MSG_DONTWAIT, nullptr);
+        for (int i{0}; (i < numberOfMessages) && (nullptr != m_delegate); i++) {
+            const std::size_t INDEX{static_cast<std::size_t>(i)};
+            std::chrono::system_clock::time_point timestamp;
+            bool hasTimeStamp{false};
+            std::size_t segmentSize{0};
+            auto toTimePoint = [](const struct timespec &receivedTimeStamp) {
+                // Transform struct timespec to C++ chrono.
+                std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> transformedTimePoint(
+                    std::chrono::nanoseconds(static_cast<int64_t>(receivedTimeStamp.tv_sec) * 1000000000L + receivedTimeStamp.tv_nsec));
+                return std::chrono::time_point_cast<std::chrono::system_clock::duration>(transformedTimePoint);
+            };
+            for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&messages[INDEX].msg_hdr); nullptr != cmsg; // NOLINT
+                 cmsg                 = CMSG_NXTHDR(&messages[INDEX].msg_hdr, cmsg)) {          // NOLINT
+                if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPNS == cmsg->cmsg_type)) {
+                    struct timespec receivedTimeStamp {};
+                    std::memcpy(&receivedTimeStamp, CMSG_DATA(cmsg), sizeof(receivedTimeStamp)); /* Flawfinder: ignore */ // NOLINT
+                    timestamp    = toTimePoint(receivedTimeStamp);
+                    hasTimeStamp = true;
+                }
+                if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_TIMESTAMPING == cmsg->cmsg_type)) {
+                    // The kernel's time stamp is followed by a deprecated one and the network card's one.
+                    std::array<struct timespec, 3> receivedTimeStamps{};
+                    std::memcpy(receivedTimeStamps.data(), CMSG_DATA(cmsg), sizeof(receivedTimeStamps)); /* Flawfinder: ignore */ // NOLINT
+                    const bool HAS_HARDWARE_TIMESTAMP{(0 != receivedTimeStamps[2].tv_sec) || (0 != receivedTimeStamps[2].tv_nsec)};
+                    const bool HAS_SOFTWARE_TIMESTAMP{(0 != receivedTimeStamps[0].tv_sec) || (0 != receivedTimeStamps[0].tv_nsec)};
+                    if (HAS_HARDWARE_TIMESTAMP || HAS_SOFTWARE_TIMESTAMP) {
+                        timestamp    = toTimePoint(receivedTimeStamps[HAS_HARDWARE_TIMESTAMP ? 2 : 0]);
+                        hasTimeStamp = true;
                     }
+                }
+#ifdef UDP_GRO
+                if ((IPPROTO_UDP == cmsg->cmsg_level) && (UDP_GRO == cmsg->cmsg_type)) {
+                    int length{0};
+                    std::memcpy(&length, CMSG_DATA(cmsg), sizeof(length)); /* Flawfinder: ignore */ // NOLINT
+                    segmentSize = (0 < length) ? static_cast<std::size_t>(length) : 0;
+                }
+#endif
+            }
+            if (!hasTimeStamp) {
+                // In case no kernel time stamp is available, fall back to chrono.
+                timestamp = std::chrono::system_clock::now();
+            }
 
-                    // Create a pipeline entry to be processed concurrently.
-                    if (!sentFromUs) {
-                        PipelineEntry pe;
-                        pe.m_data       = std::string(buffer.data(), static_cast<size_t>(bytesRead));
-                        pe.m_from       = std::string(remoteAddress.data()) + ':' + std::to_string(RECVFROM_PORT);
-                        pe.m_sampleTime = timestamp;
+            const std::size_t LENGTH{messages[INDEX].msg_len};
+            totalBytesRead += static_cast<ssize_t>(LENGTH);
 
-                        // Store entry in queue.
-                        if (m_pipeline) {
-                            m_pipeline->add(std::move(pe));
-                        }
+            // Drop our own datagrams before splitting them; the slab is reused.
+            if (isSentFromUs(remotes[INDEX])) {
+                continue;
+            }
+            if ((0 < segmentSize) && (segmentSize < LENGTH)) {
+                // Split coalesced datagrams by copying each segment into a right-sized slab; the large slab is kept for the next receive.
+                for (std::size_t offset{0}; offset < LENGTH; offset += segmentSize) {
+                    const std::size_t SIZE{std::min(segmentSize, LENGTH - offset)};
+                    ReceiveBuffer segment{(SIZE <= SMALL_DATAGRAM_LENGTH) ? m_smallReceiveBufferPool->acquire() : m_receiveBufferPool->acquire()};
+                    if (nullptr != segment.data()) {
+                        segment.size(SIZE);
+                        std::memcpy(segment.data(), m_receiveBuffers[INDEX].data() + offset, SIZE); /* Flawfinder: ignore */ // NOLINT
+                        std::chrono::system_clock::time_point segmentTimeStamp{timestamp};
+                        handleReceivedBytes(std::move(segment), remotes[INDEX], std::move(segmentTimeStamp));
                     }
-                    totalBytesRead += bytesRead;
                 }
-            } while (!m_isBlockingSocket && (bytesRead > 0));
+            } else {
+                m_receiveBuffers[INDEX].size(LENGTH);
+                handleReceivedBytes(toRightSizedBuffer(m_receiveBuffers[INDEX]), remotes[INDEX], std::move(timestamp));
+            }
         }
+        // A partially filled batch indicates that the socket has been drained; stop reading when the queue is full.
+    } while ((static_cast<int>(MAX_DATAGRAMS) == numberOfMessages) && m_backlog.empty());
+#else
+    struct sockaddr_storage remote {};
+    socklen_t addrLength{sizeof(remote)};
 
-        if (static_cast<int32_t>(totalBytesRead) > 0) {
-            if (m_pipeline) {
-                m_pipeline->notifyAll();
+    ssize_t bytesRead{0};
+    do {
+        if (nullptr == m_receiveBuffers[0].data()) {
+            m_receiveBuffers[0] = m_receiveBufferPool->acquire();
+            if (nullptr == m_receiveBuffers[0].data()) {
+                break; // LCOV_EXCL_LINE
             }
         }
+        bytesRead = ::recvfrom(m_socket,
+                               m_receiveBuffers[0].data(),
+                               m_receiveBuffers[0].capacity(),
+                               0,
+                               reinterpret_cast<struct sockaddr *>(&remote), // NOLINT
+                               reinterpret_cast<socklen_t *>(&addrLength));  // NOLINT
+
+        if ((0 < bytesRead) && (nullptr != m_delegate) && !isSentFromUs(*reinterpret_cast<struct sockaddr_in *>(&remote))) { // NOLINT
+            std::chrono::system_clock::time_point timestamp = std::chrono::system_clock::now();
+            m_receiveBuffers[0].size(static_cast<std::size_t>(bytesRead));
+            totalBytesRead += bytesRead;
+            handleReceivedBytes(toRightSizedBuffer(m_receiveBuffers[0]), *reinterpret_cast<struct sockaddr_in *>(&remote), std::move(timestamp)); // NOLINT
+        }
+    } while (!m_isBlockingSocket && (bytesRead > 0) && m_backlog.empty());
+#endif
+
+    if (static_cast<int32_t>(totalBytesRead) > 0) {
+        if (m_pipeline) {
+            m_pipeline->notifyAll();
+        }
+        if (m_pipelinePool) {
+            m_pipelinePool->notifyAll();
+        }
+    }
+    if (!m_backlog.empty()) {
+        pauseReading();
     }
 }
 } // namespace cluon
@@ -19,8 +19,13 @@
     #include <sys/types.h>
     #include <unistd.h>
 #endif
+
+#ifdef __linux__
+    #include <netinet/udp.h>
+#endif
 // clang-format on
 
+#include <array>
 #include <cerrno>
 #include <cstring>
 #include <algorithm>
@@ -133,6 +138,19 @@ UDPSender::UDPSender(const std::string &sendToAddress, uint16_t sendToPort) noex
             }
         }
 
+#if defined(__linux__) && defined(UDP_SEGMENT)
+        if (!(m_socket < 0)) {
+            // Check whether the kernel can split large buffers into datagrams (generic segmentation offload).
+            int segmentSize{0};
+            socklen_t length = sizeof(segmentSize);
+            if (0 == ::getsockopt(m_socket, IPPROTO_UDP, UDP_SEGMENT, &segmentSize, &length)) {
+                m_maxSegmentSize = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                   - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                   - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+            }
+        }
+#endif
+
 #ifdef WIN32
         if (m_socket < 0) {
             std::cerr << "[cluon::UDPSender] Error while creating socket: " << WSAGetLastError() << std::endl;
@@ -156,10 +174,51 @@ UDPSender::~UDPSender() noexcept {
     m_socket = -1;
 }
 
+std::size_t UDPSender::maxPayloadForPathMTU() const noexcept {
+    std::size_t retVal{0};
+#if defined(__linux__) && defined(IP_MTU)
+    // IP_MTU is only available for a connected socket; connecting a UDP socket does not send anything.
+    const int32_t PROBE{::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP)};
+    if (!(PROBE < 0)) {
+        if (0 == ::connect(PROBE, reinterpret_cast<const struct sockaddr *>(&m_sendToAddress), sizeof(m_sendToAddress))) { // NOLINT
+            int mtu{0};
+            socklen_t length = sizeof(mtu);
+            constexpr int HEADERS{static_cast<int>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER) + static_cast<int>(UDPPacketSizeConstraints::SIZE_UDP_HEADER)};
+            if ((0 == ::getsockopt(PROBE, IPPROTO_IP, IP_MTU, &mtu, &length)) && (HEADERS < mtu)) {
+                retVal = static_cast<std::size_t>(mtu - HEADERS);
+            }
+        }
+        ::close(PROBE);
+    }
+#endif
+    return retVal;
+}
+
 uint16_t UDPSender::getSendFromPort() const noexcept {
     return m_portToSentFrom;
 }
 
+bool UDPSender::hasSegmentationOffload() const noexcept {
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+    return (0 < m_maxSegmentSize);
+}
+
+bool UDPSender::setMulticastLoopback(bool enabled) noexcept {
+    if (m_socket < 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+    // Windows expects a DWORD whereas POSIX systems expect an unsigned char.
+#ifdef WIN32
+    DWORD loop = (enabled ? 1 : 0);
+#else
+    unsigned char loop = (enabled ? 1 : 0);
+#endif
+    // clang-format off
+    return (0 == ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_LOOP, reinterpret_cast<char *>(&loop), sizeof(loop))); // NOLINT
+    // clang-format on
+}
+
 std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noexcept {
     if (-1 == m_socket) {
         return {-1, EBADF};
@@ -186,4 +245,127 @@ std::pair<ssize_t, int32_t> UDPSender::send(std::string &&data) const noexcept {
 
     return {bytesSent, (0 > bytesSent ? errno : 0)};
 }
+
+std::pair<ssize_t, int32_t> UDPSender::send(std::vector<std::string> &&data) const noexcept {
+    if (-1 == m_socket) {
+        return {-1, EBADF};
+    }
+
+    constexpr uint16_t MAX_LENGTH = static_cast<uint16_t>(UDPPacketSizeConstraints::MAX_SIZE_UDP_PACKET)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_IPv4_HEADER)
+                                    - static_cast<uint16_t>(UDPPacketSizeConstraints::SIZE_UDP_HEADER);
+    for (const auto &datagram : data) {
+        if (MAX_LENGTH < datagram.size()) {
+            return {-1, E2BIG};
+        }
+    }
+
+    ssize_t totalBytesSent{0};
+    int32_t errorCode{0};
+
+    std::lock_guard<std::mutex> lck(m_socketMutex);
+#ifdef __linux__
+    // Hand over up to MAX_DATAGRAMS datagrams per system call. When generic
+    // segmentation offload is available, consecutive datagrams of the same
+    // size (only the last one may be shorter) are passed as one message with
+    // several iovecs that the kernel splits into datagrams again.
+    constexpr std::size_t MAX_DATAGRAMS{64};
+    constexpr std::size_t CONTROL_LENGTH{CMSG_SPACE(sizeof(uint16_t))};
+    std::array<struct iovec, MAX_DATAGRAMS> iovecs{};
+    std::array<struct mmsghdr, MAX_DATAGRAMS> messages{};
+    std::array<std::size_t, MAX_DATAGRAMS> firstDatagramOfMessage{};
+    std::array<char, MAX_DATAGRAMS * CONTROL_LENGTH> control{};
+
+    std::size_t next{0};
+    while ((next < data.size()) && (0 == errorCode)) {
+        std::size_t numberOfMessages{0};
+        std::size_t numberOfIovecs{0};
+        while ((next < data.size()) && (numberOfIovecs < MAX_DATAGRAMS)) {
+            if (data[next].empty()) {
+                next++;
+                continue;
+            }
+
+            const std::size_t SEGMENT_SIZE{data[next].size()};
+            const bool USE_SEGMENTATION{SEGMENT_SIZE <= m_maxSegmentSize};
+            struct msghdr &msg = messages[numberOfMessages].msg_hdr;
+            msg                = {};
+            msg.msg_name       = const_cast<struct sockaddr_in *>(&m_sendToAddress); // NOLINT
+            msg.msg_namelen    = sizeof(m_sendToAddress);
+            msg.msg_iov        = &iovecs[numberOfIovecs];
+            firstDatagramOfMessage[numberOfMessages] = next;
+
+            std::size_t bytes{0};
+            std::size_t segments{0};
+            do {
+                iovecs[numberOfIovecs].iov_base = const_cast<char *>(data[next].data()); // NOLINT
+                iovecs[numberOfIovecs].iov_len  = data[next].size();
+                bytes += data[next].size();
+                numberOfIovecs++;
+                segments++;
+                next++;
+            } while (USE_SEGMENTATION && (next < data.size()) && (numberOfIovecs < MAX_DATAGRAMS) && !data[next].empty()
+                     && (data[next - 1].size() == SEGMENT_SIZE) && (data[next].size() <= SEGMENT_SIZE) && (bytes + data[next].size() <= MAX_LENGTH));
+            msg.msg_iovlen = segments;
+
+#ifdef UDP_SEGMENT
+            if (1 < segments) {
+                msg.msg_control       = &control[numberOfMessages * CONTROL_LENGTH];
+                msg.msg_controllen    = CONTROL_LENGTH;
+                struct cmsghdr *cmsg  = CMSG_FIRSTHDR(&msg);
+                cmsg->cmsg_level      = IPPROTO_UDP;
+                cmsg->cmsg_type       = UDP_SEGMENT;
+                cmsg->cmsg_len        = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t LENGTH = static_cast<uint16_t>(SEGMENT_SIZE);
+                std::memcpy(CMSG_DATA(cmsg), &LENGTH, sizeof(LENGTH)); /* Flawfinder: ignore */ // NOLINT
+            }
+#endif
+            messages[numberOfMessages].msg_len = 0;
+            numberOfMessages++;
+        }
+
+        // sendmmsg could send only a part of the datagrams.
+        std::size_t sent{0};
+        while ((sent < numberOfMessages) && (0 == errorCode)) {
+            int retVal = ::sendmmsg(m_socket, &messages[sent], static_cast<unsigned int>(numberOfMessages - sent), 0);
+            if (0 > retVal) {
+                const int ERROR_CODE{errno};
+                if ((1 < messages[sent].msg_hdr.msg_iovlen) && ((EIO == ERROR_CODE) || (EINVAL == ERROR_CODE))) {
+                    // Fall back to plain datagrams: Without checksum offload (EIO), segmentation is not available
+                    // at all; otherwise (EINVAL), the segment size could exceed the MTU of the path to the receiver.
+                    const std::size_t SEGMENT_SIZE{messages[sent].msg_hdr.msg_iov[0].iov_len};
+                    const std::size_t MAX_PAYLOAD{(EINVAL == ERROR_CODE) ? maxPayloadForPathMTU() : 0};
+                    m_maxSegmentSize = (MAX_PAYLOAD < SEGMENT_SIZE) ? MAX_PAYLOAD : 0;
+                    next             = firstDatagramOfMessage[sent];
+                    break;
+                }
+                errorCode = ERROR_CODE;
+            } else {
+                for (int i{0}; i < retVal; i++) {
+                    totalBytesSent += static_cast<ssize_t>(messages[sent + static_cast<std::size_t>(i)].msg_len);
+                }
+                sent += static_cast<std::size_t>(retVal);
+            }
+        }
+    }
+#else
+    for (const auto &datagram : data) {
+        if (!datagram.empty()) {
+            ssize_t bytesSent = ::sendto(m_socket,
+                                         datagram.c_str(),
+                                         datagram.length(),
+                                         0,
+                                         reinterpret_cast<const struct sockaddr *>(&m_sendToAddress), // NOLINT
+                                         sizeof(m_sendToAddress));
+            if (0 > bytesSent) {
+                errorCode = errno;
+                break;
+            }
+            totalBytesSent += bytesSent;
+        }
+    }
+#endif
+
+    return {((0 != errorCode) && (0 == totalBytesSent)) ? -1 : totalBytesSent, errorCode};
+}
 } // namespace cluon
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/Envelope.hpp"
+#include "cluon/EnvelopeView.hpp"
+#include "cluon/FromProtoVisitor.hpp"
+#include "cluon/ToProtoVisitor.hpp"
+#include "cluon/cluonTestDataStructures.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Extract EnvelopeView from OD4-framed Envelope.") {
+    testdata::MyTestMessage5 msg;
+    msg.attribute11("Hello cluon World!");
+
+    cluon::ToProtoVisitor protoEncoder;
+    msg.accept(protoEncoder);
+    const std::string PAYLOAD{protoEncoder.encodedData()};
+
+    cluon::data::TimeStamp sent;
+    sent.seconds(1).microseconds(2);
+    cluon::data::TimeStamp received;
+    received.seconds(3).microseconds(4);
+    cluon::data::TimeStamp sampleTimeStamp;
+    sampleTimeStamp.seconds(5).microseconds(6);
+
+    cluon::data::Envelope env;
+    env.dataType(-testdata::MyTestMessage5::ID())
+        .serializedData(PAYLOAD)
+        .sent(sent)
+        .received(received)
+        .sampleTimeStamp(sampleTimeStamp)
+        .senderStamp(7);
+
+    const std::string DATA{cluon::serializeEnvelope(std::move(env))};
+
+    auto retVal = cluon::extractEnvelopeView(DATA.data(), DATA.size());
+    REQUIRE(retVal.first);
+    cluon::EnvelopeView view{retVal.second};
+    REQUIRE(-testdata::MyTestMessage5::ID() == view.dataType());
+    REQUIRE(7 == view.senderStamp());
+    REQUIRE(1 == view.sent().seconds());
+    REQUIRE(2 == view.sent().microseconds());
+    REQUIRE(3 == view.received().seconds());
+    REQUIRE(4 == view.received().microseconds());
+    REQUIRE(5 == view.sampleTimeStamp().seconds());
+    REQUIRE(6 == view.sampleTimeStamp().microseconds());
+
+    // Payload is referenced within the given buffer.
+    REQUIRE(PAYLOAD.size() == view.serializedDataLength());
+    REQUIRE(view.serializedData() > DATA.data());
+    REQUIRE(view.serializedData() < DATA.data() + DATA.size());
+    REQUIRE(0 == std::memcmp(PAYLOAD.data(), view.serializedData(), PAYLOAD.size()));
+
+    testdata::MyTestMessage5 msg2;
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(view.serializedData(), view.serializedDataLength(), msg2);
+    REQUIRE("Hello cluon World!" == msg2.attribute11());
+
+    cluon::data::Envelope env2{view.envelope()};
+    REQUIRE(-testdata::MyTestMessage5::ID() == env2.dataType());
+    REQUIRE(PAYLOAD == env2.serializedData());
+    REQUIRE(7 == env2.senderStamp());
+    REQUIRE(5 == env2.sampleTimeStamp().seconds());
+    REQUIRE(6 == env2.sampleTimeStamp().microseconds());
+}
+
+TEST_CASE("Extract EnvelopeView from invalid data.") {
+    REQUIRE(!cluon::extractEnvelopeView(nullptr, 0).first);
+
+    const std::string NO_HEADER{"Hello World"};
+    REQUIRE(!cluon::extractEnvelopeView(NO_HEADER.data(), NO_HEADER.size()).first);
+
+    cluon::data::Envelope env;
+    env.dataType(1).serializedData("Hello World");
+    const std::string DATA{cluon::serializeEnvelope(std::move(env))};
+    // Truncated frame.
+    REQUIRE(!cluon::extractEnvelopeView(DATA.data(), DATA.size() - 1).first);
+}
+
+TEST_CASE("Extract EnvelopeViews from stream reusing a buffer.") {
+    std::stringstream sstr;
+    for (int32_t i{1}; i < 4; i++) {
+        cluon::data::Envelope env;
+        env.dataType(i).serializedData(std::string(static_cast<std::size_t>(i * 100), 'a')).senderStamp(static_cast<uint32_t>(i));
+        sstr << cluon::serializeEnvelope(std::move(env));
+    }
+
+    std::string frame;
+    for (int32_t i{1}; i < 4; i++) {
+        auto retVal = cluon::extractEnvelopeView(sstr, frame);
+        REQUIRE(retVal.first);
+        REQUIRE(i == retVal.second.dataType());
+        REQUIRE(static_cast<uint32_t>(i) == retVal.second.senderStamp());
+        REQUIRE(static_cast<std::size_t>(i * 100) == retVal.second.serializedDataLength());
+        REQUIRE(retVal.second.serializedData() > frame.data());
+    }
+    REQUIRE(!cluon::extractEnvelopeView(sstr, frame).first);
+}
+
+TEST_CASE("Scan EnvelopeViews from stream skipping the payload.") {
+    std::stringstream sstr;
+    for (int32_t i{1}; i < 4; i++) {
+        cluon::data::TimeStamp sampleTimeStamp;
+        sampleTimeStamp.seconds(i).microseconds(i * 10);
+        cluon::data::Envelope env;
+        env.dataType(-i)
+            .serializedData(std::string(static_cast<std::size_t>(i * 1000), 'a'))
+            .sampleTimeStamp(sampleTimeStamp)
+            .senderStamp(static_cast<uint32_t>(i));
+        sstr << cluon::serializeEnvelope(std::move(env));
+    }
+
+    std::string buffer;
+    for (int32_t i{1}; i < 4; i++) {
+        auto retVal = cluon::scanEnvelopeView(sstr, buffer);
+        REQUIRE(retVal.first);
+        REQUIRE(-i == retVal.second.dataType());
+        REQUIRE(static_cast<uint32_t>(i) == retVal.second.senderStamp());
+        REQUIRE(i == retVal.second.sampleTimeStamp().seconds());
+        REQUIRE(i * 10 == retVal.second.sampleTimeStamp().microseconds());
+        REQUIRE(nullptr == retVal.second.serializedData());
+        REQUIRE(0 == retVal.second.serializedDataLength());
+        // Payload is not read.
+        REQUIRE(buffer.size() < 32);
+    }
+    REQUIRE(!cluon::scanEnvelopeView(sstr, buffer).first);
+}
+
+TEST_CASE("Scan EnvelopeViews from stream and track the consumed bytes.") {
+    std::vector<std::string> records;
+    for (std::size_t size : {std::size_t{10}, std::size_t{100000}, std::size_t{20}}) {
+        cluon::data::Envelope env;
+        env.dataType(static_cast<int32_t>(size)).serializedData(std::string(size, 'a')).senderStamp(3);
+        records.push_back(cluon::serializeEnvelope(std::move(env)));
+    }
+    // Handcrafted Envelope ending with its skipped payload: dataType 2 and payload "abc".
+    records.push_back(std::string{"\x0D\xA4\x07\x00\x00\x08\x04\x12\x03\x61\x62\x63", 12});
+
+    std::stringstream sstr;
+    for (const auto &record : records) {
+        sstr << record;
+    }
+
+    std::string buffer;
+    uint64_t position{0};
+    for (const auto &record : records) {
+        uint64_t consumedBytes{0};
+        auto retVal = cluon::scanEnvelopeView(sstr, buffer, consumedBytes);
+        REQUIRE(retVal.first);
+        REQUIRE(record.size() == consumedBytes);
+        position += consumedBytes;
+    }
+    REQUIRE(sstr.str().size() == position);
+    REQUIRE(2 == cluon::extractEnvelopeView(records.back().data(), records.back().size()).second.dataType());
+    uint64_t consumedBytes{1};
+    REQUIRE(!cluon::scanEnvelopeView(sstr, buffer, consumedBytes).first);
+    REQUIRE(0 == consumedBytes);
+}
+
+TEST_CASE("Scan EnvelopeView from truncated stream.") {
+    cluon::data::Envelope env;
+    env.dataType(1).serializedData("Hello World").senderStamp(2);
+    const std::string DATA{cluon::serializeEnvelope(std::move(env))};
+
+    std::stringstream sstr{DATA.substr(0, DATA.size() - 1)};
+    std::string buffer;
+    REQUIRE(!cluon::scanEnvelopeView(sstr, buffer).first);
+}
+
+TEST_CASE("Scan EnvelopeView from stream truncated within a skipped payload.") {
+    // dataType 2 followed by a payload of 100 bytes of which only 10 are available.
+    std::string data{"\x0D\xA4\x68\x00\x00\x08\x02\x12\x64", 9};
+    data += std::string(10, 'a');
+
+    std::stringstream sstr{data};
+    std::string buffer;
+    REQUIRE(!cluon::scanEnvelopeView(sstr, buffer).first);
+}
+
+TEST_CASE("Scan EnvelopeView with a key exceeding the Envelope.") {
+    // An Envelope of one byte whose overlong key for a length-delimited dataType is followed by a huge length.
+    const std::string DATA{"\x0D\xA4\x01\x00\x00\x8A\x00\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x0F", 16};
+
+    std::stringstream sstr{DATA};
+    std::string buffer;
+    REQUIRE(!cluon::scanEnvelopeView(sstr, buffer).first);
+}
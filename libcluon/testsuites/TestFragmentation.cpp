@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/Fragmentation.hpp"
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Fragment data and reassemble in reverse order.") {
+    std::string data(1000, '\0');
+    for (std::size_t i{0}; i < data.size(); i++) {
+        data[i] = static_cast<char>(i % 251);
+    }
+
+    auto fragments = cluon::fragment(data, 7, 118);
+    REQUIRE(10 == fragments.size());
+    for (const auto &f : fragments) {
+        REQUIRE(cluon::isFragment(f.data(), f.size()));
+        REQUIRE(118 >= f.size());
+    }
+    REQUIRE(!cluon::isFragment(data.data(), data.size()));
+
+    cluon::FragmentReassembler reassembler{std::chrono::milliseconds(100), 1024 * 1024};
+    const auto NOW = std::chrono::steady_clock::now();
+    for (std::size_t i{fragments.size() - 1}; i > 0; i--) {
+        auto retVal = reassembler.add(fragments[i].data(), fragments[i].size(), 1, NOW);
+        REQUIRE(!retVal.first);
+    }
+    auto duplicate = reassembler.add(fragments[3].data(), fragments[3].size(), 1, NOW);
+    REQUIRE(!duplicate.first);
+
+    // Same message identifier from another sender is a different message.
+    auto other = reassembler.add(fragments[0].data(), fragments[0].size(), 2, NOW);
+    REQUIRE(!other.first);
+
+    auto retVal = reassembler.add(fragments[0].data(), fragments[0].size(), 1, NOW);
+    REQUIRE(retVal.first);
+    REQUIRE(data == retVal.second);
+
+    auto stats = reassembler.statistics();
+    REQUIRE(12 == stats.receivedFragments);
+    REQUIRE(1 == stats.duplicateFragments);
+    REQUIRE(1 == stats.completedMessages);
+    REQUIRE(1 == stats.pendingMessages);
+    REQUIRE(1000 == stats.pendingBytes);
+}
+
+TEST_CASE("Fragment data with invalid sizes.") {
+    REQUIRE(cluon::fragment("Hello", 1, cluon::FRAGMENT_HEADER_SIZE).empty());
+    REQUIRE(cluon::fragment(std::string(70000, 'A'), 1, cluon::FRAGMENT_HEADER_SIZE + 1).empty());
+
+    auto fragments = cluon::fragment("", 1, 100);
+    REQUIRE(1 == fragments.size());
+
+    cluon::FragmentReassembler reassembler{std::chrono::milliseconds(100), 1024};
+    auto retVal = reassembler.add(fragments[0].data(), fragments[0].size(), 1, std::chrono::steady_clock::now());
+    REQUIRE(retVal.first);
+    REQUIRE(retVal.second.empty());
+
+    // Truncated fragment and message too large for the reassembler.
+    auto retVal2 = reassembler.add(fragments[0].data(), 5, 1, std::chrono::steady_clock::now());
+    REQUIRE(!retVal2.first);
+    auto tooLarge = cluon::fragment(std::string(2000, 'A'), 2, 1000);
+    auto retVal3  = reassembler.add(tooLarge[0].data(), tooLarge[0].size(), 1, std::chrono::steady_clock::now());
+    REQUIRE(!retVal3.first);
+
+    REQUIRE(2 == reassembler.statistics().invalidFragments);
+}
+
+TEST_CASE("Reassembling fragments drops expired and evicted messages.") {
+    cluon::FragmentReassembler reassembler{std::chrono::milliseconds(100), 2500};
+    const auto NOW = std::chrono::steady_clock::now();
+
+    auto first  = cluon::fragment(std::string(1000, 'A'), 1, 218);
+    auto second = cluon::fragment(std::string(1000, 'B'), 2, 218);
+    auto third  = cluon::fragment(std::string(1000, 'C'), 3, 218);
+    REQUIRE(5 == first.size());
+
+    REQUIRE(!reassembler.add(first[0].data(), first[0].size(), 1, NOW).first);
+    REQUIRE(!reassembler.add(second[0].data(), second[0].size(), 1, NOW + std::chrono::milliseconds(10)).first);
+    REQUIRE(!reassembler.add(second[1].data(), second[1].size(), 1, NOW + std::chrono::milliseconds(10)).first);
+
+    // Not enough memory for three messages: the first one is evicted.
+    REQUIRE(!reassembler.add(third[0].data(), third[0].size(), 1, NOW + std::chrono::milliseconds(20)).first);
+    auto stats = reassembler.statistics();
+    REQUIRE(1 == stats.evictedMessages);
+    REQUIRE(4 == stats.lostFragments);
+    REQUIRE(2 == stats.pendingMessages);
+
+    // After the timeout, the second message has expired; the third one is still pending.
+    REQUIRE(!reassembler.add(third[1].data(), third[1].size(), 1, NOW + std::chrono::milliseconds(115)).first);
+    stats = reassembler.statistics();
+    REQUIRE(1 == stats.expiredMessages);
+    REQUIRE(4 + 3 == stats.lostFragments);
+    REQUIRE(1 == stats.pendingMessages);
+
+    for (std::size_t i{2}; i < third.size(); i++) {
+        auto retVal = reassembler.add(third[i].data(), third[i].size(), 1, NOW + std::chrono::milliseconds(116));
+        REQUIRE((i + 1 == third.size()) == retVal.first);
+        if (retVal.first) {
+            REQUIRE(std::string(1000, 'C') == retVal.second);
+        }
+    }
+    stats = reassembler.statistics();
+    REQUIRE(0 == stats.pendingMessages);
+    REQUIRE(0 == stats.pendingBytes);
+}
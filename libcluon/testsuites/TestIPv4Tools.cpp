@@ -11,6 +11,14 @@
 #include "cluon/cluon.hpp"  // Necessary for the correcting linker settings on Win32.
 #include "cluon/IPv4Tools.hpp"
 
+// clang-format off
+#ifdef WIN32
+    #include <Winsock2.h>
+#else
+    #include <arpa/inet.h>
+#endif
+// clang-format on
+
 TEST_CASE("Test hostname resolution localhost to 127.0.0.1.") {
     std::string resolvedHostname = cluon::getIPv4FromHostname("localhost");
     REQUIRE(resolvedHostname == "127.0.0.1");
@@ -34,3 +42,12 @@ TEST_CASE("Test hostname resolution 127.0.1 to 127.0.0.1.") {
     REQUIRE(resolvedHostname == "127.0.0.1");
 #endif
 }
+
+TEST_CASE("Test encoding and decoding compact sender addresses.") {
+    // 127.0.0.1 in network byte order.
+    const uint32_t ADDRESS{htonl(0x7F000001)};
+    const uint64_t SENDER{cluon::encodeSenderAddress(ADDRESS, 12175)};
+    REQUIRE(((static_cast<uint64_t>(0x7F000001) << 16) | 12175) == SENDER);
+    REQUIRE("127.0.0.1:12175" == cluon::decodeSenderAddress(SENDER));
+    REQUIRE("0.0.0.0:0" == cluon::decodeSenderAddress(0));
+}
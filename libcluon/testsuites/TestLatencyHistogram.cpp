@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/LatencyHistogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Empty LatencyHistogram.") {
+    cluon::LatencyHistogram histogram;
+    auto stats = histogram.statistics();
+    REQUIRE(0 == stats.samples);
+    REQUIRE(0 == stats.minLatencyInNanoseconds);
+    REQUIRE(0 == stats.maxLatencyInNanoseconds);
+    REQUIRE(0 == histogram.percentile(99.0));
+    REQUIRE(histogram.buckets().empty());
+}
+
+TEST_CASE("Record latencies and compute percentiles.") {
+    cluon::LatencyHistogram histogram;
+    for (uint64_t i{1}; i <= 1000; i++) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+
+    auto stats = histogram.statistics();
+    REQUIRE(1000 == stats.samples);
+    REQUIRE(0 == stats.negativeSamples);
+    REQUIRE(1000 == stats.minLatencyInNanoseconds);
+    REQUIRE(1000000 == stats.maxLatencyInNanoseconds);
+    REQUIRE(500500 == stats.meanLatencyInNanoseconds);
+
+    // Percentiles are upper bounds of buckets that are at most 25% wide.
+    auto isClose = [](uint64_t value, uint64_t expected) { return (expected <= value) && (value <= expected + expected / 4); };
+    REQUIRE(isClose(stats.medianLatencyInNanoseconds, 500000));
+    REQUIRE(isClose(stats.percentile90LatencyInNanoseconds, 900000));
+    REQUIRE(isClose(stats.percentile99LatencyInNanoseconds, 990000));
+    REQUIRE(1000000 == stats.percentile999LatencyInNanoseconds);
+    REQUIRE(1000000 == histogram.percentile(100.0));
+    REQUIRE(isClose(histogram.percentile(0.0), 1000));
+
+    uint64_t samples{0};
+    uint64_t previousUpperBound{0};
+    for (const auto &bucket : histogram.buckets()) {
+        REQUIRE(previousUpperBound < bucket.first);
+        previousUpperBound = bucket.first;
+        samples += bucket.second;
+    }
+    REQUIRE(1000 == samples);
+
+    histogram.reset();
+    REQUIRE(0 == histogram.statistics().samples);
+    REQUIRE(histogram.buckets().empty());
+}
+
+TEST_CASE("Record small, huge, and negative latencies.") {
+    cluon::LatencyHistogram histogram;
+    histogram.record(std::chrono::nanoseconds(0));
+    histogram.record(std::chrono::nanoseconds(3));
+    histogram.record(std::chrono::nanoseconds(-5));
+    histogram.record(std::chrono::nanoseconds(std::numeric_limits<int64_t>::max()));
+
+    auto stats = histogram.statistics();
+    REQUIRE(4 == stats.samples);
+    REQUIRE(1 == stats.negativeSamples);
+    REQUIRE(0 == stats.minLatencyInNanoseconds);
+    REQUIRE(static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) == stats.maxLatencyInNanoseconds);
+    REQUIRE(0 == histogram.percentile(50.0));
+    REQUIRE(3 == histogram.percentile(75.0));
+
+    auto buckets = histogram.buckets();
+    REQUIRE(3 == buckets.size());
+    REQUIRE(0 == buckets[0].first);
+    REQUIRE(2 == buckets[0].second);
+    REQUIRE(3 == buckets[1].first);
+}
+
+TEST_CASE("Record latencies from several threads.") {
+    cluon::LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (uint32_t t{0}; t < 4; t++) {
+        threads.emplace_back([&histogram, t]() {
+            for (int64_t i{0}; i < 10000; i++) {
+                histogram.record(std::chrono::nanoseconds(1000 * (t + 1)));
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    auto stats = histogram.statistics();
+    REQUIRE(40000 == stats.samples);
+    REQUIRE(1000 == stats.minLatencyInNanoseconds);
+    REQUIRE(4000 == stats.maxLatencyInNanoseconds);
+    REQUIRE(2500 == stats.meanLatencyInNanoseconds);
+}
+
+TEST_CASE("Disabled LatencyHistogram ignores latencies.") {
+    cluon::LatencyHistogram histogram{false};
+    REQUIRE(!histogram.isEnabled());
+    histogram.record(std::chrono::microseconds(5));
+    REQUIRE(0 == histogram.statistics().samples);
+
+    histogram.setEnabled(true);
+    REQUIRE(histogram.isEnabled());
+    histogram.record(std::chrono::microseconds(5));
+    REQUIRE(1 == histogram.statistics().samples);
+
+    histogram.setEnabled(false);
+    histogram.record(std::chrono::microseconds(5));
+    REQUIRE(1 == histogram.statistics().samples);
+}
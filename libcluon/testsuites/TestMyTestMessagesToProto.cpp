@@ -9,6 +9,7 @@
 #include "catch.hpp"
 
 #include "cluon/FromProtoVisitor.hpp"
+#include "cluon/ProtoSizeVisitor.hpp"
 #include "cluon/ToProtoVisitor.hpp"
 #include "cluon/cluon.hpp"
 #include "cluon/cluonTestDataStructures.hpp"
@@ -17,6 +18,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 TEST_CASE("Testing MyTestMessage0.") {
     testdata::MyTestMessage0 tmp;
@@ -372,3 +374,101 @@ TEST_CASE("Testing MyTestMessage7 with visitor to visit nested messages for seri
                   []() {});
     std::cout << buffer.str() << std::endl;
 }
+
+TEST_CASE("Testing MyTestMessage13 with large nested message encoded in place.") {
+    testdata::MyTestMessage4 tmp4;
+    tmp4.attribute1(std::string(300, 'x'));
+    testdata::MyTestMessage13 tmp13;
+    tmp13.attribute1(tmp4).attribute2(42);
+
+    cluon::ToProtoVisitor protoEncoder;
+    tmp13.accept(protoEncoder);
+    const std::string s{protoEncoder.encodedData()};
+
+    // Key (1 byte) + length of nested message (2 bytes) + nested key (1 byte)
+    // + length of string (2 bytes) + 300 bytes + key/value for attribute2 (2 bytes).
+    REQUIRE(308 == s.size());
+    REQUIRE(s.size() == protoEncoder.encodedSize());
+    REQUIRE(0xa == static_cast<uint8_t>(s.at(0)));
+    REQUIRE(0xaf == static_cast<uint8_t>(s.at(1)));
+    REQUIRE(0x2 == static_cast<uint8_t>(s.at(2)));
+
+    std::stringstream sstr{s};
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(sstr);
+
+    testdata::MyTestMessage13 tmp13_2;
+    tmp13_2.accept(protoDecoder);
+    REQUIRE(std::string(300, 'x') == tmp13_2.attribute1().attribute1());
+    REQUIRE(42 == tmp13_2.attribute2());
+}
+
+TEST_CASE("Testing ToProtoVisitor with caller-supplied buffer and reuse.") {
+    std::string buffer{"AB"};
+    cluon::ToProtoVisitor protoEncoder{buffer};
+
+    testdata::MyTestMessage2 tmp2;
+    tmp2.attribute1(150);
+    tmp2.accept(protoEncoder);
+
+    REQUIRE(5 == buffer.size());
+    REQUIRE(3 == protoEncoder.encodedSize());
+    REQUIRE("AB" == buffer.substr(0, 2));
+    REQUIRE(buffer.substr(2) == protoEncoder.encodedData());
+
+    protoEncoder.reset();
+    REQUIRE("AB" == buffer);
+    REQUIRE(0 == protoEncoder.encodedSize());
+
+    tmp2.attribute1(1);
+    tmp2.accept(protoEncoder);
+    REQUIRE(4 == buffer.size());
+    REQUIRE(0x8 == static_cast<uint8_t>(buffer.at(2)));
+    REQUIRE(0x1 == static_cast<uint8_t>(buffer.at(3)));
+}
+
+TEST_CASE("Testing ProtoSizeVisitor to match the size of the encoded data.") {
+    testdata::MyTestMessage5 tmp5;
+    tmp5.attribute2(-128).attribute4(-30000).attribute6(-2000000).attribute8(-1).attribute11(std::string(200, 'y'));
+
+    cluon::ProtoSizeVisitor sizeVisitor5;
+    tmp5.accept(sizeVisitor5);
+
+    cluon::ToProtoVisitor protoEncoder5;
+    tmp5.accept(protoEncoder5);
+    REQUIRE(protoEncoder5.encodedData().size() == sizeVisitor5.encodedSize());
+
+    testdata::MyTestMessage4 tmp4;
+    tmp4.attribute1(std::string(300, 'x'));
+    testdata::MyTestMessage13 tmp13;
+    tmp13.attribute1(tmp4);
+
+    std::vector<std::size_t> nestedSizes;
+    cluon::ProtoSizeVisitor sizeVisitor13{nestedSizes};
+    tmp13.accept(sizeVisitor13);
+
+    cluon::ToProtoVisitor protoEncoder13;
+    tmp13.accept(protoEncoder13);
+    REQUIRE(protoEncoder13.encodedData().size() == sizeVisitor13.encodedSize());
+    REQUIRE(1 == nestedSizes.size());
+    REQUIRE(303 == nestedSizes.at(0));
+}
+
+TEST_CASE("Testing MyTestMessage3 decoded from unordered and duplicate fields.") {
+    // Field 2 (ZigZag-encoded -2), field 1 (5), and field 1 again (7).
+    const std::string s{"\x10\x03\x08\x05\x08\x07", 6};
+
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(s.data(), s.size());
+
+    testdata::MyTestMessage3 tmp3;
+    tmp3.accept(protoDecoder);
+    REQUIRE(5 == tmp3.attribute1());
+    REQUIRE(-2 == tmp3.attribute2());
+
+    // Fields with a mismatching wire type are ignored.
+    testdata::MyTestMessage4 tmp4;
+    tmp4.attribute1("unchanged");
+    tmp4.accept(protoDecoder);
+    REQUIRE("unchanged" == tmp4.attribute1());
+}
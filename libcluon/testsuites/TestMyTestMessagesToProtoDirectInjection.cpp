@@ -361,3 +361,52 @@ TEST_CASE("Testing MyTestMessage7 with visitor to visit nested messages for seri
                   []() {});
     std::cout << buffer.str() << std::endl;
 }
+
+TEST_CASE("Testing MyTestMessage7 with direct decoding from contiguous buffer.") {
+    testdata::MyTestMessage7 tmp7;
+
+    testdata::MyTestMessage2 tmp2_1;
+    tmp7.attribute1(tmp2_1.attribute1(9));
+    tmp7.attribute2(12);
+    testdata::MyTestMessage2 tmp2_3;
+    tmp7.attribute3(tmp2_3.attribute1(13));
+
+    cluon::ToProtoVisitor protoEncoder;
+    tmp7.accept(protoEncoder);
+    std::string s = protoEncoder.encodedData();
+    REQUIRE(10 == s.size());
+
+    testdata::MyTestMessage7 tmp7_2;
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(s.data(), s.size(), tmp7_2);
+
+    REQUIRE(9 == tmp7_2.attribute1().attribute1());
+    REQUIRE(12 == tmp7_2.attribute2());
+    REQUIRE(13 == tmp7_2.attribute3().attribute1());
+
+    // Truncated buffers must not be read beyond their end.
+    testdata::MyTestMessage7 tmp7_3;
+    protoDecoder.decodeFrom(s.data(), 9, tmp7_3);
+    REQUIRE(9 == tmp7_3.attribute1().attribute1());
+    REQUIRE(12 == tmp7_3.attribute2());
+    REQUIRE(123 == tmp7_3.attribute3().attribute1());
+}
+
+TEST_CASE("Testing MyTestMessage5 with direct decoding of strings from contiguous buffer.") {
+    testdata::MyTestMessage5 tmp5;
+    tmp5.attribute9(1.5f).attribute10(-2.25).attribute11("Hello Buffer!");
+
+    cluon::ToProtoVisitor protoEncoder;
+    tmp5.accept(protoEncoder);
+    const std::string s{protoEncoder.encodedData()};
+
+    testdata::MyTestMessage5 tmp5_2;
+    cluon::FromProtoVisitor protoDecoder;
+    protoDecoder.decodeFrom(s.data(), s.size(), tmp5_2);
+
+    REQUIRE(tmp5.attribute1() == tmp5_2.attribute1());
+    REQUIRE(tmp5.attribute8() == tmp5_2.attribute8());
+    REQUIRE(1.5f == Approx(tmp5_2.attribute9()));
+    REQUIRE(-2.25 == Approx(tmp5_2.attribute10()));
+    REQUIRE("Hello Buffer!" == tmp5_2.attribute11());
+}
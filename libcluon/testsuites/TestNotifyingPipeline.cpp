@@ -12,9 +12,11 @@
 
 #include <atomic>
 #include <chrono>
+#include <ctime>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 TEST_CASE("Creating a NotifyingPipeline and stop immediately.") {
     cluon::NotifyingPipeline<std::string> pipeline(nullptr);
@@ -47,3 +49,279 @@ TEST_CASE("Creating a NotifyingPipeline, add one entry, and get notified.") {
         REQUIRE("Hello World" == data);
     } catch (...) { REQUIRE(false); } // LCOV_EXCL_LINE
 }
+
+TEST_CASE("Creating a bounded NotifyingPipeline handing over move-only entries.") {
+    std::atomic<uint32_t> entriesReceived{0};
+    std::vector<int> data;
+
+    cluon::NotifyingPipeline<std::unique_ptr<int>> pipeline(
+        [&entriesReceived, &data](std::unique_ptr<int> &&entry) {
+            data.push_back(*entry);
+            entriesReceived++;
+        },
+        8,
+        cluon::FullQueuePolicy::BLOCK);
+    REQUIRE(pipeline.isRunning());
+
+    // Adding more entries than the capacity blocks until the pipeline thread made room.
+    constexpr int MAX_ENTRIES{1000};
+    for (int i{0}; i < MAX_ENTRIES; i++) {
+        pipeline.add(std::unique_ptr<int>(new int(i)));
+    }
+    pipeline.notifyAll();
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < MAX_ENTRIES);
+
+    REQUIRE(MAX_ENTRIES == data.size());
+    for (int i{0}; i < MAX_ENTRIES; i++) {
+        REQUIRE(i == data[static_cast<std::size_t>(i)]);
+    }
+    REQUIRE(0 == pipeline.droppedEntries());
+}
+
+TEST_CASE("Creating a bounded NotifyingPipeline whose producer sleeps while the queue is full.") {
+    std::atomic<uint32_t> entriesReceived{0};
+    cluon::NotifyingPipeline<int> pipeline(
+        [&entriesReceived](int &&) {
+            using namespace std::literals::chrono_literals; // NOLINT
+            std::this_thread::sleep_for(2ms);
+            entriesReceived++;
+        },
+        4,
+        cluon::FullQueuePolicy::BLOCK);
+
+    // The producer waits for room most of the time; it must not spin meanwhile.
+    constexpr uint32_t MAX_ENTRIES{100};
+    const std::clock_t CPU_BEFORE{std::clock()};
+    const auto BEFORE{std::chrono::steady_clock::now()};
+    for (uint32_t i{0}; i < MAX_ENTRIES; i++) {
+        pipeline.add(static_cast<int>(i));
+        pipeline.notifyAll();
+    }
+    const auto WALL{std::chrono::steady_clock::now() - BEFORE};
+    const double CPU_IN_SECONDS{static_cast<double>(std::clock() - CPU_BEFORE) / CLOCKS_PER_SEC};
+
+    REQUIRE(WALL > std::chrono::milliseconds(150));
+    REQUIRE(CPU_IN_SECONDS < 0.5 * std::chrono::duration<double>(WALL).count());
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < MAX_ENTRIES);
+    REQUIRE(0 == pipeline.droppedEntries());
+}
+
+TEST_CASE("Creating a bounded NotifyingPipeline dropping newest or oldest entries.") {
+    for (auto policy : {cluon::FullQueuePolicy::DROP_NEWEST, cluon::FullQueuePolicy::DROP_OLDEST}) {
+        std::atomic<bool> delegateEntered{false};
+        std::atomic<bool> delegateReleased{false};
+        std::atomic<uint32_t> entriesReceived{0};
+        std::vector<int> data;
+
+        cluon::NotifyingPipeline<int> pipeline(
+            [&delegateEntered, &delegateReleased, &entriesReceived, &data](int &&entry) {
+                delegateEntered.store(true);
+                using namespace std::literals::chrono_literals; // NOLINT
+                while (!delegateReleased.load()) { std::this_thread::sleep_for(1ms); }
+                data.push_back(entry);
+                entriesReceived++;
+            },
+            4,
+            policy);
+
+        // Block the pipeline thread in the delegate with the first entry.
+        pipeline.add(0);
+        pipeline.notifyAll();
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (!delegateEntered.load());
+
+        for (int i{1}; i <= 10; i++) {
+            pipeline.add(int{i});
+        }
+        REQUIRE(6 == pipeline.droppedEntries());
+
+        delegateReleased.store(true);
+        pipeline.notifyAll();
+        do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < 5);
+
+        REQUIRE(5 == data.size());
+        REQUIRE(0 == data[0]);
+        const int FIRST{(cluon::FullQueuePolicy::DROP_NEWEST == policy) ? 1 : 7};
+        for (std::size_t i{1}; i < data.size(); i++) {
+            REQUIRE(FIRST + static_cast<int>(i) - 1 == data[i]);
+        }
+    }
+}
+
+TEST_CASE("Creating a NotifyingPipeline with batch delegate draining all pending entries.") {
+    for (std::size_t capacity : {std::size_t{0}, std::size_t{16}}) {
+        std::atomic<uint32_t> entriesReceived{0};
+        std::atomic<uint32_t> batchesReceived{0};
+        std::vector<int> data;
+
+        cluon::NotifyingPipeline<int> pipeline(
+            [&entriesReceived, &batchesReceived, &data](std::vector<int> &&entries) {
+                for (auto e : entries) { data.push_back(e); }
+                batchesReceived++;
+                entriesReceived += static_cast<uint32_t>(entries.size());
+            },
+            capacity,
+            cluon::FullQueuePolicy::BLOCK);
+        REQUIRE(pipeline.isRunning());
+
+        constexpr int MAX_ENTRIES{1000};
+        for (int i{0}; i < MAX_ENTRIES; i++) {
+            pipeline.add(int{i});
+            if (0 == (i % 100)) {
+                pipeline.notifyAll();
+            }
+        }
+        pipeline.notifyAll();
+
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < MAX_ENTRIES);
+
+        REQUIRE(MAX_ENTRIES == data.size());
+        for (int i{0}; i < MAX_ENTRIES; i++) {
+            REQUIRE(i == data[static_cast<std::size_t>(i)]);
+        }
+        REQUIRE(batchesReceived.load() < static_cast<uint32_t>(MAX_ENTRIES));
+
+        auto stats = pipeline.statistics();
+        REQUIRE(0 == stats.queueDepth);
+        REQUIRE(MAX_ENTRIES == stats.enqueuedEntries);
+        REQUIRE(0 == stats.droppedEntries);
+        REQUIRE(0 < stats.maxQueueDepth);
+        REQUIRE(batchesReceived.load() == stats.delegateCalls);
+        REQUIRE(stats.maxDelegateLatencyInMicroseconds <= stats.totalDelegateLatencyInMicroseconds);
+    }
+}
+
+TEST_CASE("Creating an unbounded NotifyingPipeline with high-water mark dropping oldest entries.") {
+    std::atomic<bool> delegateEntered{false};
+    std::atomic<bool> delegateReleased{false};
+    std::atomic<uint32_t> entriesReceived{0};
+    std::vector<int> data;
+
+    cluon::NotifyingPipeline<int> pipeline(
+        [&delegateEntered, &delegateReleased, &entriesReceived, &data](std::vector<int> &&entries) {
+            delegateEntered.store(true);
+            using namespace std::literals::chrono_literals; // NOLINT
+            while (!delegateReleased.load()) { std::this_thread::sleep_for(1ms); }
+            for (auto e : entries) { data.push_back(e); }
+            entriesReceived += static_cast<uint32_t>(entries.size());
+        },
+        0,
+        cluon::FullQueuePolicy::DROP_OLDEST);
+    pipeline.setHighWaterMark(3);
+
+    // Block the pipeline thread in the delegate with the first entry.
+    pipeline.add(0);
+    pipeline.notifyAll();
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!delegateEntered.load());
+
+    for (int i{1}; i <= 10; i++) {
+        pipeline.add(int{i});
+    }
+    auto stats = pipeline.statistics();
+    REQUIRE(3 == stats.queueDepth);
+    REQUIRE(3 == stats.maxQueueDepth);
+    REQUIRE(11 == stats.enqueuedEntries);
+    REQUIRE(7 == stats.droppedEntries);
+    REQUIRE(0 == stats.delegateCalls);
+
+    delegateReleased.store(true);
+    pipeline.notifyAll();
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < 4);
+
+    REQUIRE(4 == data.size());
+    REQUIRE(0 == data[0]);
+    REQUIRE(8 == data[1]);
+    REQUIRE(9 == data[2]);
+    REQUIRE(10 == data[3]);
+
+    stats = pipeline.statistics();
+    REQUIRE(0 == stats.queueDepth);
+    REQUIRE(2 == stats.delegateCalls);
+}
+
+TEST_CASE("Measuring the delegate latency of a NotifyingPipeline only when enabled.") {
+    std::atomic<uint32_t> entriesReceived{0};
+
+    cluon::NotifyingPipeline<int> pipeline(
+        [&entriesReceived](int &&) {
+            using namespace std::literals::chrono_literals; // NOLINT
+            std::this_thread::sleep_for(2ms);
+            entriesReceived++;
+        },
+        16,
+        cluon::FullQueuePolicy::BLOCK);
+    REQUIRE(pipeline.isRunning());
+    REQUIRE(!pipeline.isDelegateLatencyEnabled());
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    pipeline.add(1);
+    pipeline.notifyAll();
+    // The counters are updated after the delegate has returned.
+    do { std::this_thread::sleep_for(1ms); } while (pipeline.statistics().delegateCalls < 1);
+
+    auto stats = pipeline.statistics();
+    REQUIRE(1 == stats.delegateCalls);
+    REQUIRE(0 == stats.totalDelegateLatencyInMicroseconds);
+    REQUIRE(0 == stats.maxDelegateLatencyInMicroseconds);
+
+    pipeline.setDelegateLatencyEnabled(true);
+    REQUIRE(pipeline.isDelegateLatencyEnabled());
+    pipeline.add(2);
+    pipeline.add(3);
+    pipeline.notifyAll();
+    do { std::this_thread::sleep_for(1ms); } while (pipeline.statistics().delegateCalls < 3);
+
+    stats = pipeline.statistics();
+    REQUIRE(3 == entriesReceived.load());
+    REQUIRE(2000 <= stats.maxDelegateLatencyInMicroseconds);
+    REQUIRE(2 * 2000 <= stats.totalDelegateLatencyInMicroseconds);
+}
+
+TEST_CASE("Changing the scheduling of a NotifyingPipeline's thread.") {
+    std::atomic<uint32_t> entriesReceived{0};
+    cluon::NotifyingPipeline<int> pipeline([&entriesReceived](int &&) { entriesReceived++; });
+
+    REQUIRE(pipeline.setScheduling(0, -1));
+#ifdef __linux__
+    REQUIRE(!pipeline.setScheduling(0, CPU_SETSIZE));
+#endif
+
+    pipeline.add(1);
+    pipeline.notifyAll();
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < 1);
+    REQUIRE(1 == entriesReceived.load());
+}
+
+TEST_CASE("Querying the queue depth of a bounded NotifyingPipeline while entries are added and processed.") {
+    std::atomic<uint32_t> entriesReceived{0};
+    cluon::NotifyingPipeline<int> pipeline([&entriesReceived](int &&) { entriesReceived++; }, 16, cluon::FullQueuePolicy::BLOCK);
+
+    std::atomic<bool> adding{true};
+    std::thread producer([&pipeline, &adding]() noexcept {
+        for (int i{0}; i < 100000; i++) {
+            pipeline.add(int{i});
+            pipeline.notifyAll();
+        }
+        adding.store(false);
+    });
+
+    // The depth must never underflow, whatever the order of the concurrent updates.
+    uint64_t maxQueueDepth{0};
+    while (adding.load()) {
+        const uint64_t DEPTH{pipeline.statistics().queueDepth};
+        maxQueueDepth = (DEPTH > maxQueueDepth) ? DEPTH : maxQueueDepth;
+    }
+    producer.join();
+    REQUIRE(16 >= maxQueueDepth);
+    REQUIRE(16 >= pipeline.statistics().maxQueueDepth);
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < 100000);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/NotifyingPipelinePool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Creating a NotifyingPipelinePool preserving the order per key.") {
+    for (std::size_t capacity : {std::size_t{0}, std::size_t{8}}) {
+        constexpr std::size_t KEYS{8};
+        constexpr int ENTRIES_PER_KEY{100};
+
+        std::atomic<uint32_t> entriesReceived{0};
+        std::mutex dataMutex;
+        std::vector<std::vector<int>> data(KEYS);
+        std::mutex threadsMutex;
+        std::vector<std::thread::id> threads;
+
+        // Entries are pairs of (key, sequence number).
+        cluon::NotifyingPipelinePool<std::pair<std::size_t, int>> pool(
+            4,
+            [](const std::pair<std::size_t, int> &entry) { return entry.first; },
+            [&entriesReceived, &dataMutex, &data, &threadsMutex, &threads](std::pair<std::size_t, int> &&entry) {
+                {
+                    std::lock_guard<std::mutex> lck(dataMutex);
+                    data[entry.first].push_back(entry.second);
+                }
+                {
+                    std::lock_guard<std::mutex> lck(threadsMutex);
+                    if (threads.end() == std::find(threads.begin(), threads.end(), std::this_thread::get_id())) {
+                        threads.push_back(std::this_thread::get_id());
+                    }
+                }
+                entriesReceived++;
+            },
+            capacity);
+        REQUIRE(pool.isRunning());
+        REQUIRE(4 == pool.numberOfWorkers());
+
+        for (int i{0}; i < ENTRIES_PER_KEY; i++) {
+            for (std::size_t key{0}; key < KEYS; key++) {
+                pool.add(std::make_pair(key, i));
+            }
+            pool.notifyAll();
+        }
+
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < KEYS * ENTRIES_PER_KEY);
+
+        for (std::size_t key{0}; key < KEYS; key++) {
+            REQUIRE(ENTRIES_PER_KEY == data[key].size());
+            for (int i{0}; i < ENTRIES_PER_KEY; i++) {
+                REQUIRE(i == data[key][static_cast<std::size_t>(i)]);
+            }
+        }
+        // Unrelated keys are spread across workers.
+        REQUIRE(1 < threads.size());
+
+        auto stats = pool.statistics();
+        REQUIRE(KEYS * ENTRIES_PER_KEY == stats.enqueuedEntries);
+        REQUIRE(KEYS * ENTRIES_PER_KEY == stats.delegateCalls);
+        REQUIRE(0 == stats.droppedEntries);
+    }
+}
+
+TEST_CASE("Creating a NotifyingPipelinePool without ordering key.") {
+    std::atomic<uint32_t> entriesReceived{0};
+
+    cluon::NotifyingPipelinePool<int> pool(3, nullptr, [&entriesReceived](int &&) { entriesReceived++; });
+    REQUIRE(pool.isRunning());
+
+    for (int i{0}; i < 30; i++) {
+        pool.add(int{i});
+    }
+    pool.notifyAll();
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (entriesReceived.load() < 30);
+
+    REQUIRE(30 == pool.statistics().delegateCalls);
+}
@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -499,3 +500,401 @@ TEST_CASE("Create OD4 session with dataTrigger and transmission storm from 5 thr
 #endif
 #endif
 }
+
+TEST_CASE("Create OD4 session with several workers and receive data in order per senderStamp.") {
+    constexpr uint32_t SENDERS{4};
+    constexpr int32_t ENVELOPES_PER_SENDER{20};
+
+    std::atomic<uint32_t> envelopesReceived{0};
+    std::mutex dataMutex;
+    std::vector<std::vector<int64_t>> data(SENDERS);
+
+    cluon::OD4Session od4(
+        82,
+        [&envelopesReceived, &dataMutex, &data](cluon::data::Envelope &&envelope) {
+            const uint32_t SENDER{envelope.senderStamp()};
+            cluon::data::TimeStamp ts = cluon::extractMessage<cluon::data::TimeStamp>(std::move(envelope));
+            std::lock_guard<std::mutex> lck(dataMutex);
+            data[SENDER].push_back(ts.seconds());
+            envelopesReceived++;
+        },
+        4);
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+    REQUIRE(od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(82);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+    REQUIRE(od4ToSendFrom.isRunning());
+
+    for (int32_t i{0}; i < ENVELOPES_PER_SENDER; i++) {
+        for (uint32_t sender{0}; sender < SENDERS; sender++) {
+            cluon::data::TimeStamp ts;
+            ts.seconds(i);
+            od4ToSendFrom.send(ts, cluon::data::TimeStamp(), sender);
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    const auto START{std::chrono::steady_clock::now()};
+    do { std::this_thread::sleep_for(1ms); } while ((envelopesReceived.load() < SENDERS * ENVELOPES_PER_SENDER) && (std::chrono::steady_clock::now() - START < 5s));
+
+    // UDP might lose datagrams; the received ones must be in order per senderStamp.
+    REQUIRE(0 < envelopesReceived.load());
+    std::lock_guard<std::mutex> lck(dataMutex);
+    for (uint32_t sender{0}; sender < SENDERS; sender++) {
+        for (std::size_t i{1}; i < data[sender].size(); i++) {
+            REQUIRE(data[sender][i - 1] < data[sender][i]);
+        }
+    }
+}
+
+TEST_CASE("Create OD4 session and send batches of Envelopes.") {
+    std::mutex receivedMutex;
+    std::vector<int32_t> received;
+
+    cluon::OD4Session od4(90);
+    od4.dataTrigger(cluon::data::TimeStamp::ID(), [&receivedMutex, &received](cluon::data::Envelope &&envelope) {
+        cluon::data::TimeStamp ts = cluon::extractMessage<cluon::data::TimeStamp>(std::move(envelope));
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        received.push_back(ts.seconds());
+    });
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(90);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    // Envelopes are queued until flush.
+    od4ToSendFrom.beginBatch();
+    for (int32_t i{0}; i < 3; i++) {
+        cluon::data::TimeStamp ts;
+        ts.seconds(i);
+        od4ToSendFrom.send(ts);
+    }
+    std::this_thread::sleep_for(100ms);
+    {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        REQUIRE(received.empty());
+    }
+    od4ToSendFrom.flush();
+
+    // Send a list of Envelopes at once.
+    std::vector<cluon::data::Envelope> envelopes;
+    for (int32_t i{3}; i < 5; i++) {
+        cluon::data::TimeStamp ts;
+        ts.seconds(i);
+        cluon::ToProtoVisitor protoEncoder;
+        ts.accept(protoEncoder);
+        cluon::data::Envelope envelope;
+        envelope.dataType(cluon::data::TimeStamp::ID()).serializedData(protoEncoder.encodedData());
+        envelopes.push_back(envelope);
+    }
+    od4ToSendFrom.send(std::move(envelopes));
+
+    // Every time slice is sent at once.
+    od4ToSendFrom.batchTimeTrigger(true);
+    int32_t counter{5};
+    od4ToSendFrom.timeTrigger(20.0, [&od4ToSendFrom, &counter]() {
+        for (int32_t i{0}; i < 2; i++) {
+            cluon::data::TimeStamp ts;
+            ts.seconds(counter++);
+            od4ToSendFrom.send(ts);
+        }
+        return (counter < 9);
+    });
+
+    bool allReceived{false};
+    for (int32_t i{0}; (i < 5000) && !allReceived; i++) {
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        allReceived = (9 == received.size());
+    }
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    REQUIRE(9 == received.size());
+    for (int32_t i{0}; i < 9; i++) {
+        REQUIRE(i == received[static_cast<std::size_t>(i)]);
+    }
+}
+
+TEST_CASE("Create OD4 session and transmit a large Envelope as fragments.") {
+    std::atomic<bool> replyReceived{false};
+    cluon::data::Envelope reply;
+
+    cluon::OD4Session od4(91, [&reply, &replyReceived](cluon::data::Envelope &&envelope) {
+        reply         = envelope;
+        replyReceived = true;
+    });
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(91);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    std::string largePayload(200000, '\0');
+    for (std::size_t i{0}; i < largePayload.size(); i++) {
+        largePayload[i] = static_cast<char>(i % 253);
+    }
+    cluon::data::Envelope envelope;
+    envelope.dataType(1234).senderStamp(5).serializedData(largePayload);
+
+    // Without fragmentation, the Envelope is too large to be sent.
+    cluon::data::Envelope copy{envelope};
+    od4ToSendFrom.send(std::move(copy));
+    std::this_thread::sleep_for(100ms);
+    REQUIRE(!replyReceived);
+
+    od4ToSendFrom.fragmentLargeEnvelopes(true);
+    od4ToSendFrom.send(std::move(envelope));
+
+    for (int32_t i{0}; (i < 5000) && !replyReceived; i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(replyReceived);
+    REQUIRE(1234 == reply.dataType());
+    REQUIRE(5 == reply.senderStamp());
+    REQUIRE(largePayload == reply.serializedData());
+
+    auto stats = od4.fragmentStatistics();
+    REQUIRE(4 == stats.receivedFragments);
+    REQUIRE(1 == stats.completedMessages);
+    REQUIRE(0 == stats.lostFragments);
+}
+
+TEST_CASE("Create OD4 session with several workers and receive fragmented and small Envelopes.") {
+    std::mutex receivedMutex;
+    std::vector<cluon::data::Envelope> received;
+
+    cluon::OD4Session od4(
+        97,
+        [&receivedMutex, &received](cluon::data::Envelope &&envelope) {
+            std::lock_guard<std::mutex> lck(receivedMutex);
+            received.push_back(std::move(envelope));
+        },
+        3);
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(97);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+    od4ToSendFrom.fragmentLargeEnvelopes(true);
+
+    std::string largePayload(100000, '\0');
+    for (std::size_t i{0}; i < largePayload.size(); i++) {
+        largePayload[i] = static_cast<char>(i % 251);
+    }
+    cluon::data::Envelope large;
+    large.dataType(1234).senderStamp(7).serializedData(largePayload);
+    od4ToSendFrom.send(std::move(large));
+    cluon::data::Envelope small;
+    small.dataType(4321).senderStamp(8).serializedData("Hello");
+    od4ToSendFrom.send(std::move(small));
+
+    for (int32_t i{0}; i < 5000; i++) {
+        {
+            std::lock_guard<std::mutex> lck(receivedMutex);
+            if (2 == received.size()) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+
+    // The decoded meta data is handed to the workers together with the bytes it refers to.
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    REQUIRE(2 == received.size());
+    for (const auto &envelope : received) {
+        if (1234 == envelope.dataType()) {
+            REQUIRE(7 == envelope.senderStamp());
+            REQUIRE(largePayload == envelope.serializedData());
+        } else {
+            REQUIRE(4321 == envelope.dataType());
+            REQUIRE(8 == envelope.senderStamp());
+            REQUIRE("Hello" == envelope.serializedData());
+        }
+    }
+}
+
+TEST_CASE("Create OD4 session without multicast loopback does not deliver to local OD4 sessions.") {
+    std::atomic<uint32_t> envelopesReceived{0};
+
+    cluon::OD4Session od4(92, [&envelopesReceived](cluon::data::Envelope &&) { envelopesReceived++; });
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(92);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    REQUIRE(od4ToSendFrom.multicastLoopback(false));
+    cluon::data::TimeStamp ts;
+    od4ToSendFrom.send(ts);
+    std::this_thread::sleep_for(100ms);
+    REQUIRE(0 == envelopesReceived.load());
+
+    REQUIRE(od4ToSendFrom.multicastLoopback(true));
+    od4ToSendFrom.send(ts);
+    for (int32_t i{0}; (i < 5000) && (0 == envelopesReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(1 == envelopesReceived.load());
+}
+
+TEST_CASE("Create OD4 session with several receivers and receive data once and in order per dataType.") {
+    std::mutex receivedMutex;
+    std::map<int32_t, std::vector<int32_t>> received;
+    std::atomic<uint32_t> envelopesReceived{0};
+
+    cluon::OD4Session od4(
+        94,
+        [&receivedMutex, &received, &envelopesReceived](cluon::data::Envelope &&envelope) {
+            std::lock_guard<std::mutex> lck(receivedMutex);
+            received[envelope.dataType()].push_back(std::stoi(envelope.serializedData()));
+            envelopesReceived++;
+        },
+        1,
+        3);
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(94);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    constexpr int32_t NUMBER_OF_DATATYPES{6};
+    constexpr int32_t NUMBER_OF_ENVELOPES{50};
+    for (int32_t i{0}; i < NUMBER_OF_ENVELOPES; i++) {
+        std::vector<cluon::data::Envelope> envelopes;
+        for (int32_t dataType{100}; dataType < 100 + NUMBER_OF_DATATYPES; dataType++) {
+            cluon::data::Envelope envelope;
+            envelope.dataType(dataType).serializedData(std::to_string(i));
+            envelopes.push_back(envelope);
+        }
+        od4ToSendFrom.send(std::move(envelopes));
+    }
+
+    for (int32_t i{0}; (i < 5000) && (NUMBER_OF_DATATYPES * NUMBER_OF_ENVELOPES > static_cast<int32_t>(envelopesReceived.load())); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(100ms);
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    REQUIRE(NUMBER_OF_DATATYPES * NUMBER_OF_ENVELOPES == static_cast<int32_t>(envelopesReceived.load()));
+    for (const auto &e : received) {
+        REQUIRE(NUMBER_OF_ENVELOPES == static_cast<int32_t>(e.second.size()));
+        for (int32_t i{0}; i < NUMBER_OF_ENVELOPES; i++) {
+            REQUIRE(i == e.second[static_cast<std::size_t>(i)]);
+        }
+    }
+}
+
+TEST_CASE("Create OD4 session and record delivery and transport latencies.") {
+    std::atomic<uint32_t> envelopesReceived{0};
+
+    cluon::OD4Session od4(95, [&envelopesReceived](cluon::data::Envelope &&) { envelopesReceived++; });
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+#ifdef __linux__
+    REQUIRE(od4.timeStampMode(cluon::ReceiveTimeStampMode::HARDWARE));
+#endif
+    REQUIRE(0 == od4.deliveryLatency().statistics().samples);
+    REQUIRE(0 == od4.transportLatency().statistics().samples);
+    REQUIRE(!od4.deliveryLatency().isEnabled());
+    REQUIRE(!od4.transportLatency().isEnabled());
+    od4.deliveryLatency().setEnabled(true);
+    od4.transportLatency().setEnabled(true);
+
+    cluon::OD4Session od4ToSendFrom(95);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    cluon::data::TimeStamp ts;
+    for (uint32_t i{0}; i < 10; i++) {
+        od4ToSendFrom.send(ts);
+    }
+    for (int32_t i{0}; (i < 5000) && (10 > envelopesReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(10 == envelopesReceived.load());
+
+    auto delivery = od4.deliveryLatency().statistics();
+    REQUIRE(10 == delivery.samples);
+    REQUIRE(0 == delivery.negativeSamples);
+
+    // Envelope.sent has a resolution of microseconds; sender and receiver share the clock.
+    auto transport = od4.transportLatency().statistics();
+    REQUIRE(10 == transport.samples);
+    REQUIRE(0 == transport.negativeSamples);
+    REQUIRE(transport.maxLatencyInNanoseconds < 5000000000ull);
+}
+
+TEST_CASE("Create OD4 session with a dispatch lane that is not delayed by slow delegates.") {
+    std::atomic<uint32_t> bulkReceived{0};
+    std::atomic<uint32_t> bulkReceivedWhenCriticalCompleted{0};
+    std::mutex criticalMutex;
+    std::vector<int32_t> critical;
+    constexpr uint32_t NUMBER_OF_ENVELOPES{5};
+
+    cluon::OD4Session od4(96);
+    REQUIRE(od4.dataTrigger(cluon::data::PlayerCommand::ID(), [&bulkReceived](cluon::data::Envelope &&) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(50ms);
+        bulkReceived++;
+    }));
+    REQUIRE(od4.dataTrigger(cluon::data::TimeStamp::ID(),
+                            [&criticalMutex, &critical, &bulkReceived, &bulkReceivedWhenCriticalCompleted](cluon::data::Envelope &&envelope) {
+                                auto ts = cluon::extractMessage<cluon::data::TimeStamp>(std::move(envelope));
+                                std::lock_guard<std::mutex> lck(criticalMutex);
+                                critical.push_back(ts.seconds());
+                                if (NUMBER_OF_ENVELOPES == critical.size()) {
+                                    bulkReceivedWhenCriticalCompleted.store(bulkReceived.load());
+                                }
+                            }));
+    REQUIRE(od4.laneStatistics().empty());
+    od4.deliveryLatency().setEnabled(true);
+    REQUIRE(od4.dispatchLane({cluon::data::TimeStamp::ID()}));
+    // A dataType must not be moved to another lane.
+    REQUIRE(!od4.dispatchLane({cluon::data::TimeStamp::ID(), cluon::data::PlayerCommand::ID()}));
+
+    cluon::OD4Session od4Catchall(96, [](cluon::data::Envelope &&) {});
+    REQUIRE(!od4Catchall.dispatchLane({cluon::data::TimeStamp::ID()}));
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(96);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    // Bulk and critical Envelopes are interleaved; critical ones must not wait for the slow delegate.
+    for (uint32_t i{0}; i < NUMBER_OF_ENVELOPES; i++) {
+        cluon::data::PlayerCommand pc;
+        od4ToSendFrom.send(pc);
+        cluon::data::TimeStamp ts;
+        ts.seconds(static_cast<int32_t>(i));
+        od4ToSendFrom.send(ts);
+    }
+
+    for (int32_t i{0}; (i < 5000) && (NUMBER_OF_ENVELOPES > bulkReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(NUMBER_OF_ENVELOPES == bulkReceived.load());
+
+    std::lock_guard<std::mutex> lck(criticalMutex);
+    REQUIRE(NUMBER_OF_ENVELOPES == critical.size());
+    for (uint32_t i{0}; i < NUMBER_OF_ENVELOPES; i++) {
+        REQUIRE(static_cast<int32_t>(i) == critical[i]);
+    }
+    REQUIRE(NUMBER_OF_ENVELOPES > bulkReceivedWhenCriticalCompleted.load());
+    REQUIRE(NUMBER_OF_ENVELOPES <= od4.deliveryLatency().statistics().samples);
+
+    auto lanes = od4.laneStatistics();
+    REQUIRE(2 == lanes.size());
+    REQUIRE(NUMBER_OF_ENVELOPES == lanes[0].enqueuedEntries);
+    REQUIRE(NUMBER_OF_ENVELOPES == lanes[1].enqueuedEntries);
+    REQUIRE(0 < lanes[0].maxQueueDepth);
+    REQUIRE(NUMBER_OF_ENVELOPES >= lanes[0].maxQueueDepth);
+}
@@ -9,6 +9,7 @@
 #include "catch.hpp"
 
 #include "cluon/Envelope.hpp"
+#include "cluon/FromProtoVisitor.hpp"
 #include "cluon/Player.hpp"
 #include "cluon/ToProtoVisitor.hpp"
 #include "cluon/cluonDataStructures.hpp"
@@ -16,8 +17,11 @@
 
 #include <cstdio>
 #include <fstream>
+#include <iostream>
+#include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 // clang-format off
 #ifdef WIN32
@@ -26,6 +30,10 @@
     #include <unistd.h>
     #define UNLINK unlink
 #endif
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#endif
 // clang-format on
 
 TEST_CASE("Create simple player for non existing file.") {
@@ -781,3 +789,391 @@ TEST_CASE("Create simple player for file with three entries with manual rewind a
     REQUIRE(6 == retrievedEntries);
     UNLINK("rec9");
 }
+
+TEST_CASE("Create memory-mapped player for file with three entries.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{true};
+    constexpr bool MEMORY_MAPPED{true};
+
+    UNLINK("rec10");
+    UNLINK("rec10.idx");
+    constexpr int32_t MAX_ENTRIES{3};
+    {
+        std::fstream recordingFile("rec10", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+
+        // Store entries in reverse sample time order.
+        for (int32_t entryCounter{MAX_ENTRIES - 1}; entryCounter >= 0; entryCounter--) {
+            testdata::MyTestMessage5 msg;
+            msg.attribute6(entryCounter + 1);
+
+            cluon::ToProtoVisitor proto;
+            msg.accept(proto);
+
+            cluon::data::Envelope env;
+            cluon::data::TimeStamp sampleTimeStamp;
+            sampleTimeStamp.seconds(10000).microseconds(entryCounter);
+
+            env.serializedData(proto.encodedData());
+            env.dataType(testdata::MyTestMessage5::ID()).sampleTimeStamp(sampleTimeStamp);
+
+            const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+            recordingFile.flush();
+        }
+        recordingFile.close();
+    }
+    cluon::Player player("rec10", AUTO_REWIND, THREADING, MEMORY_MAPPED);
+
+    REQUIRE(player.hasMoreData());
+    REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+
+    int32_t retrievedEntries{0};
+    while (player.hasMoreData()) {
+        auto entry = player.getNextEnvelopeViewToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(testdata::MyTestMessage5::ID() == entry.second.dataType());
+        REQUIRE(10000 == entry.second.sampleTimeStamp().seconds());
+        REQUIRE(retrievedEntries == entry.second.sampleTimeStamp().microseconds());
+
+        retrievedEntries++;
+
+        testdata::MyTestMessage5 msg;
+        cluon::FromProtoVisitor protoDecoder;
+        protoDecoder.decodeFrom(entry.second.serializedData(), entry.second.serializedDataLength(), msg);
+        REQUIRE(retrievedEntries == msg.attribute6());
+    }
+    REQUIRE(MAX_ENTRIES == retrievedEntries);
+
+    player.seekTo(0);
+    auto entry = player.getNextEnvelopeToBeReplayed();
+    REQUIRE(entry.first);
+    REQUIRE(0 == entry.second.sampleTimeStamp().microseconds());
+    testdata::MyTestMessage5 msg = cluon::extractMessage<testdata::MyTestMessage5>(std::move(entry.second));
+    REQUIRE(1 == msg.attribute6());
+    UNLINK("rec10");
+    UNLINK("rec10.idx");
+}
+
+TEST_CASE("Create player reusing sidecar index file.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{false};
+
+    UNLINK("rec11");
+    UNLINK("rec11.idx");
+    constexpr int32_t MAX_ENTRIES{3};
+    {
+        std::fstream recordingFile("rec11", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+
+        for (int32_t entryCounter{0}; entryCounter < MAX_ENTRIES; entryCounter++) {
+            cluon::data::Envelope env;
+            cluon::data::TimeStamp sampleTimeStamp;
+            sampleTimeStamp.seconds(10000).microseconds(entryCounter);
+            env.dataType(testdata::MyTestMessage5::ID() + entryCounter).sampleTimeStamp(sampleTimeStamp).senderStamp(static_cast<uint32_t>(entryCounter));
+
+            const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+            recordingFile.flush();
+        }
+        recordingFile.close();
+    }
+    {
+        cluon::Player player("rec11", AUTO_REWIND, THREADING);
+        REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+    }
+    {
+        std::fstream indexFile("rec11.idx", std::ios::in | std::ios::binary);
+        REQUIRE(indexFile.good());
+        indexFile.seekg(0, indexFile.end);
+        REQUIRE((32 + MAX_ENTRIES * 24) == indexFile.tellg());
+    }
+    {
+        // Index file is reused.
+        cluon::Player player("rec11", AUTO_REWIND, THREADING);
+        REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+
+        int32_t retrievedEntries{0};
+        while (player.hasMoreData()) {
+            auto entry = player.getNextEnvelopeToBeReplayed();
+            REQUIRE(entry.first);
+            REQUIRE(testdata::MyTestMessage5::ID() + retrievedEntries == entry.second.dataType());
+            REQUIRE(static_cast<uint32_t>(retrievedEntries) == entry.second.senderStamp());
+            retrievedEntries++;
+        }
+        REQUIRE(MAX_ENTRIES == retrievedEntries);
+    }
+    {
+        // Appending to the .rec file invalidates the index file.
+        std::fstream recordingFile("rec11", std::ios::out | std::ios::binary | std::ios::app);
+        REQUIRE(recordingFile.good());
+        cluon::data::Envelope env;
+        env.dataType(testdata::MyTestMessage5::ID());
+        const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+        recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+        recordingFile.close();
+    }
+    {
+        cluon::Player player("rec11", AUTO_REWIND, THREADING);
+        REQUIRE((MAX_ENTRIES + 1) == player.totalNumberOfEnvelopesInRecFile());
+    }
+    {
+        // Corrupt index file is ignored.
+        std::fstream indexFile("rec11.idx", std::ios::out | std::ios::binary | std::ios::trunc);
+        indexFile << "Hello World";
+        indexFile.close();
+
+        cluon::Player player("rec11", AUTO_REWIND, THREADING);
+        REQUIRE((MAX_ENTRIES + 1) == player.totalNumberOfEnvelopesInRecFile());
+    }
+    UNLINK("rec11");
+    UNLINK("rec11.idx");
+}
+
+#ifdef __linux__
+TEST_CASE("Create player rejecting a stale sidecar index file.") {
+    constexpr bool AUTO_REWIND{false};
+
+    UNLINK("rec16");
+    UNLINK("rec16.idx");
+    auto writeRecFile = [](const std::vector<std::size_t> &payloadSizes) {
+        std::fstream recordingFile("rec16", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+        int32_t entryCounter{0};
+        for (auto payloadSize : payloadSizes) {
+            cluon::data::Envelope env;
+            cluon::data::TimeStamp sampleTimeStamp;
+            sampleTimeStamp.seconds(10000).microseconds(entryCounter);
+            env.dataType(testdata::MyTestMessage5::ID()).sampleTimeStamp(sampleTimeStamp).serializedData(std::string(payloadSize, 'x'));
+            entryCounter++;
+
+            const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+        }
+        recordingFile.close();
+    };
+
+    writeRecFile({10, 20, 30});
+    {
+        cluon::Player player("rec16", AUTO_REWIND, false);
+        REQUIRE(3 == player.totalNumberOfEnvelopesInRecFile());
+    }
+    struct stat before {};
+    REQUIRE(0 == ::stat("rec16", &before));
+
+    // Same size and modification time (as left by a file system with coarse time stamps) but different records.
+    writeRecFile({30, 20, 10});
+    struct stat after {};
+    REQUIRE(0 == ::stat("rec16", &after));
+    REQUIRE(before.st_size == after.st_size);
+    const struct timespec TIMES[2]{before.st_atim, before.st_mtim};
+    REQUIRE(0 == ::utimensat(AT_FDCWD, "rec16", TIMES, 0));
+
+    for (bool threading : {false, true}) {
+        cluon::Player player("rec16", AUTO_REWIND, threading);
+        REQUIRE(3 == player.totalNumberOfEnvelopesInRecFile());
+
+        std::vector<std::size_t> payloadSizes;
+        while (player.hasMoreData()) {
+            auto entry = player.getNextEnvelopeToBeReplayed();
+            REQUIRE(entry.first);
+            payloadSizes.push_back(entry.second.serializedData().size());
+        }
+        REQUIRE((std::vector<std::size_t>{30, 20, 10}) == payloadSizes);
+        REQUIRE(0 == player.numberOfSkippedEnvelopes());
+    }
+
+    UNLINK("rec16");
+    UNLINK("rec16.idx");
+}
+#endif
+
+TEST_CASE("Create threaded player falling back from memory mapping to reading from file.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{true};
+    constexpr bool MEMORY_MAPPED{true};
+
+    // An empty file cannot be memory-mapped.
+    UNLINK("rec15");
+    UNLINK("rec15.idx");
+    {
+        std::fstream recordingFile("rec15", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+        recordingFile.close();
+    }
+    {
+        cluon::Player player("rec15", AUTO_REWIND, THREADING, MEMORY_MAPPED);
+        REQUIRE(0 == player.totalNumberOfEnvelopesInRecFile());
+        REQUIRE(!player.hasMoreData());
+        REQUIRE(!player.getNextEnvelopeToBeReplayed().first);
+    }
+    UNLINK("rec15");
+    UNLINK("rec15.idx");
+}
+
+TEST_CASE("Create player for file with small Envelopes reusing its index file.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{false};
+
+    UNLINK("rec14");
+    UNLINK("rec14.idx");
+    // Envelopes only containing a dataType need fewer bytes than their index entries.
+    constexpr int32_t MAX_ENTRIES{10};
+    {
+        std::fstream recordingFile("rec14", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+        for (int32_t entryCounter{0}; entryCounter < MAX_ENTRIES; entryCounter++) {
+            // OD4 header for two bytes followed by the ZigZag-encoded dataType.
+            const std::string tmp{'\x0D', '\xA4', '\x02', '\x00', '\x00', '\x08', static_cast<char>(2 * (entryCounter + 1))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+        }
+        recordingFile.close();
+    }
+    {
+        cluon::Player player("rec14", AUTO_REWIND, THREADING);
+        REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+    }
+    {
+        std::stringstream log;
+        std::streambuf *cerrBuffer{std::cerr.rdbuf(log.rdbuf())};
+        {
+            cluon::Player player("rec14", AUTO_REWIND, THREADING);
+            REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+        }
+        std::cerr.rdbuf(cerrBuffer);
+        REQUIRE(std::string::npos != log.str().find("loaded index from rec14.idx"));
+    }
+    UNLINK("rec14");
+    UNLINK("rec14.idx");
+}
+
+TEST_CASE("Create player for large file indexed in parallel.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{false};
+
+    UNLINK("rec12");
+    UNLINK("rec12.idx");
+
+    // Payload consisting of valid OD4-framed Envelopes to challenge the resynchronization.
+    std::string payload;
+    for (uint32_t i{0}; i < 40; i++) {
+        cluon::data::Envelope env;
+        env.dataType(1).serializedData(std::string(64, 'x')).senderStamp(i);
+        payload += cluon::serializeEnvelope(std::move(env));
+    }
+
+    int32_t numberOfEntries{0};
+    {
+        std::fstream recordingFile("rec12", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+
+        uint64_t size{0};
+        // Ensure that the file is large enough to be indexed in parallel on machines with several cores.
+        while (size < 33 * 1024 * 1024) {
+            cluon::data::Envelope env;
+            cluon::data::TimeStamp sampleTimeStamp;
+            sampleTimeStamp.seconds(10000 + numberOfEntries / 1000).microseconds(numberOfEntries % 1000);
+            env.dataType(testdata::MyTestMessage5::ID()).serializedData(payload).sampleTimeStamp(sampleTimeStamp).senderStamp(static_cast<uint32_t>(numberOfEntries));
+
+            const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+            size += tmp.size();
+            numberOfEntries++;
+        }
+        recordingFile.close();
+    }
+
+    for (bool memoryMapped : {false, true}) {
+        UNLINK("rec12.idx");
+        cluon::Player player("rec12", AUTO_REWIND, THREADING, memoryMapped);
+        REQUIRE(numberOfEntries == static_cast<int32_t>(player.totalNumberOfEnvelopesInRecFile()));
+
+        int32_t retrievedEntries{0};
+        while (player.hasMoreData()) {
+            auto entry = player.getNextEnvelopeViewToBeReplayed();
+            REQUIRE(entry.first);
+            REQUIRE(testdata::MyTestMessage5::ID() == entry.second.dataType());
+            REQUIRE(static_cast<uint32_t>(retrievedEntries) == entry.second.senderStamp());
+            REQUIRE(payload.size() == entry.second.serializedDataLength());
+            retrievedEntries++;
+        }
+        REQUIRE(numberOfEntries == retrievedEntries);
+    }
+    UNLINK("rec12");
+    UNLINK("rec12.idx");
+}
+
+TEST_CASE("Create player and seek by sample time stamps.") {
+    constexpr bool AUTO_REWIND{false};
+    constexpr bool THREADING{false};
+
+    UNLINK("rec13");
+    UNLINK("rec13.idx");
+    constexpr int32_t MAX_ENTRIES{10};
+    {
+        std::fstream recordingFile("rec13", std::ios::out | std::ios::binary | std::ios::trunc);
+        REQUIRE(recordingFile.good());
+
+        for (int32_t entryCounter{0}; entryCounter < MAX_ENTRIES; entryCounter++) {
+            cluon::data::Envelope env;
+            cluon::data::TimeStamp sampleTimeStamp;
+            // Sample time stamps every 100ms.
+            sampleTimeStamp.seconds(10000).microseconds(entryCounter * 100 * 1000);
+            env.dataType(testdata::MyTestMessage5::ID()).sampleTimeStamp(sampleTimeStamp).senderStamp(static_cast<uint32_t>(entryCounter));
+
+            const std::string tmp{cluon::serializeEnvelope(std::move(env))};
+            recordingFile.write(tmp.c_str(), static_cast<std::streamsize>(tmp.size()));
+            recordingFile.flush();
+        }
+        recordingFile.close();
+    }
+    cluon::Player player("rec13", AUTO_REWIND, THREADING);
+    REQUIRE(MAX_ENTRIES == player.totalNumberOfEnvelopesInRecFile());
+
+    cluon::data::TimeStamp ts;
+    ts.seconds(10000).microseconds(450 * 1000);
+    player.seekToTimeStamp(ts);
+    {
+        auto entry = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(5 == entry.second.senderStamp());
+        REQUIRE(0 == player.delay());
+    }
+    {
+        auto entry = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(6 == entry.second.senderStamp());
+        REQUIRE(100 * 1000 == player.delay());
+    }
+
+    // Relative to the next Envelope (7) to be replayed.
+    player.seekBy(-300 * 1000);
+    {
+        auto entry = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(4 == entry.second.senderStamp());
+    }
+    player.seekBy(-10 * 1000 * 1000);
+    {
+        auto entry = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(0 == entry.second.senderStamp());
+    }
+
+    // Seeking beyond the end.
+    player.seekBy(10 * 1000 * 1000);
+    REQUIRE(!player.hasMoreData());
+    REQUIRE(!player.getNextEnvelopeToBeReplayed().first);
+
+    // Seeking before the beginning.
+    ts.seconds(1).microseconds(0);
+    player.seekToTimeStamp(ts);
+    REQUIRE(player.hasMoreData());
+    {
+        auto entry = player.getNextEnvelopeToBeReplayed();
+        REQUIRE(entry.first);
+        REQUIRE(0 == entry.second.senderStamp());
+    }
+    UNLINK("rec13");
+    UNLINK("rec13.idx");
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/Reactor.hpp"
+
+// clang-format off
+#ifndef WIN32
+    #include <unistd.h>
+#endif
+// clang-format on
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+TEST_CASE("Creating a Reactor and stop immediately.") {
+    const auto START{std::chrono::steady_clock::now()};
+    {
+        cluon::Reactor reactor;
+        REQUIRE(reactor.isRunning());
+    }
+    // The event loop is woken up immediately when stopping.
+    REQUIRE(std::chrono::steady_clock::now() - START < std::chrono::milliseconds(500));
+}
+
+TEST_CASE("Creating a Reactor and get notified about readable file descriptors.") {
+    cluon::Reactor reactor;
+    REQUIRE(reactor.isRunning());
+
+    std::array<int, 2> fds{};
+    REQUIRE(0 == ::pipe(fds.data()));
+
+    std::atomic<uint32_t> calls{0};
+    REQUIRE(reactor.add(fds[0], [&fds, &calls]() {
+        char c{0};
+        auto retVal = ::read(fds[0], &c, 1);
+        (void)retVal;
+        calls++;
+    }));
+    // Registering a file descriptor twice fails.
+    REQUIRE(!reactor.add(fds[0], []() {}));
+    REQUIRE(!reactor.add(-1, []() {}));
+    REQUIRE(!reactor.add(fds[1], nullptr));
+
+    for (uint32_t i{1}; i <= 3; i++) {
+        REQUIRE(1 == ::write(fds[1], "x", 1));
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (calls.load() < i);
+    }
+    REQUIRE(3 == calls.load());
+
+    REQUIRE(reactor.remove(fds[0]));
+    REQUIRE(!reactor.remove(fds[0]));
+
+    // No delegate is called after removing.
+    REQUIRE(1 == ::write(fds[1], "x", 1));
+    using namespace std::literals::chrono_literals; // NOLINT
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(3 == calls.load());
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("Removing a file descriptor waits for its running delegate.") {
+    cluon::Reactor reactor;
+    REQUIRE(reactor.isRunning());
+
+    std::array<int, 2> fds{};
+    REQUIRE(0 == ::pipe(fds.data()));
+
+    std::atomic<bool> delegateEntered{false};
+    std::atomic<bool> delegateDone{false};
+    REQUIRE(reactor.add(fds[0], [&fds, &delegateEntered, &delegateDone, &reactor]() {
+        char c{0};
+        auto retVal = ::read(fds[0], &c, 1);
+        (void)retVal;
+        delegateEntered.store(true);
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(100ms);
+        delegateDone.store(true);
+    }));
+
+    REQUIRE(1 == ::write(fds[1], "x", 1));
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!delegateEntered.load());
+
+    REQUIRE(reactor.remove(fds[0]));
+    REQUIRE(delegateDone.load());
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("Pausing and resuming a file descriptor.") {
+    cluon::Reactor reactor;
+    REQUIRE(reactor.isRunning());
+
+    std::array<int, 2> fds{};
+    REQUIRE(0 == ::pipe(fds.data()));
+
+    std::atomic<uint32_t> calls{0};
+    REQUIRE(reactor.add(fds[0], [&fds, &calls]() {
+        char c{0};
+        auto retVal = ::read(fds[0], &c, 1);
+        (void)retVal;
+        calls++;
+    }));
+    REQUIRE(reactor.pause(fds[0]));
+    REQUIRE(!reactor.pause(-1));
+
+    // Data stays in the paused file descriptor.
+    REQUIRE(1 == ::write(fds[1], "x", 1));
+    using namespace std::literals::chrono_literals; // NOLINT
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(0 == calls.load());
+
+    REQUIRE(reactor.resume(fds[0]));
+    REQUIRE(!reactor.resume(-1));
+    do { std::this_thread::sleep_for(1ms); } while (calls.load() < 1);
+    REQUIRE(1 == calls.load());
+
+    REQUIRE(reactor.remove(fds[0]));
+    REQUIRE(!reactor.pause(fds[0]));
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_CASE("Creating a Reactor with several threads dispatching file descriptors concurrently.") {
+    cluon::Reactor reactor(2);
+    REQUIRE(reactor.isRunning());
+    REQUIRE(2 == reactor.numberOfThreads());
+
+    std::array<int, 2> slowFDs{};
+    std::array<int, 2> fastFDs{};
+    REQUIRE(0 == ::pipe(slowFDs.data()));
+    REQUIRE(0 == ::pipe(fastFDs.data()));
+
+    std::atomic<bool> slowDelegateEntered{false};
+    std::atomic<bool> slowDelegateDone{false};
+    REQUIRE(reactor.add(slowFDs[0], [&slowFDs, &slowDelegateEntered, &slowDelegateDone]() {
+        char c{0};
+        auto retVal = ::read(slowFDs[0], &c, 1);
+        (void)retVal;
+        slowDelegateEntered.store(true);
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(200ms);
+        slowDelegateDone.store(true);
+    }));
+    std::atomic<uint32_t> fastCalls{0};
+    REQUIRE(reactor.add(fastFDs[0], [&fastFDs, &fastCalls]() {
+        char c{0};
+        auto retVal = ::read(fastFDs[0], &c, 1);
+        (void)retVal;
+        fastCalls++;
+    }));
+
+    REQUIRE(1 == ::write(slowFDs[1], "x", 1));
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!slowDelegateEntered.load());
+
+    // The second thread serves the other file descriptor while the first one is busy.
+    REQUIRE(1 == ::write(fastFDs[1], "x", 1));
+    do { std::this_thread::sleep_for(1ms); } while (fastCalls.load() < 1);
+    REQUIRE(!slowDelegateDone.load());
+
+    REQUIRE(reactor.remove(slowFDs[0]));
+    REQUIRE(slowDelegateDone.load());
+    REQUIRE(reactor.remove(fastFDs[0]));
+
+    ::close(slowFDs[0]);
+    ::close(slowFDs[1]);
+    ::close(fastFDs[0]);
+    ::close(fastFDs[1]);
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/ReceiveBuffer.hpp"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Acquire and recycle slabs from a ReceiveBufferPool.") {
+    auto pool = std::make_shared<cluon::ReceiveBufferPool>(16, 2);
+    REQUIRE(16 == pool->slabSize());
+    REQUIRE(0 == pool->numberOfFreeSlabs());
+    REQUIRE(0 == pool->numberOfAllocatedSlabs());
+
+    const char *first{nullptr};
+    {
+        cluon::ReceiveBuffer b{pool->acquire()};
+        REQUIRE(nullptr != b.data());
+        REQUIRE(16 == b.capacity());
+        REQUIRE(0 == b.size());
+        first = b.data();
+
+        std::memcpy(b.data(), "Hello World", 11); /* Flawfinder: ignore */ // NOLINT
+        b.size(11);
+        REQUIRE("Hello World" == b.toString());
+
+        // The size is limited to the capacity.
+        b.size(100);
+        REQUIRE(16 == b.size());
+    }
+    REQUIRE(1 == pool->numberOfFreeSlabs());
+    REQUIRE(1 == pool->numberOfAllocatedSlabs());
+
+    // The slab is reused.
+    cluon::ReceiveBuffer b2{pool->acquire()};
+    REQUIRE(first == b2.data());
+    REQUIRE(0 == pool->numberOfFreeSlabs());
+    REQUIRE(1 == pool->numberOfAllocatedSlabs());
+
+    // Moving transfers the slab.
+    cluon::ReceiveBuffer b3{std::move(b2)};
+    REQUIRE(nullptr == b2.data()); // NOLINT
+    REQUIRE(first == b3.data());
+    b2 = std::move(b3);
+    REQUIRE(first == b2.data());
+    REQUIRE(nullptr == b3.data()); // NOLINT
+}
+
+TEST_CASE("A ReceiveBufferPool keeps at most maxFreeSlabs.") {
+    auto pool = std::make_shared<cluon::ReceiveBufferPool>(8, 2);
+    {
+        std::vector<cluon::ReceiveBuffer> buffers;
+        for (int i{0}; i < 5; i++) {
+            buffers.emplace_back(pool->acquire());
+        }
+        REQUIRE(5 == pool->numberOfAllocatedSlabs());
+    }
+    REQUIRE(2 == pool->numberOfFreeSlabs());
+}
+
+TEST_CASE("A ReceiveBuffer keeps its pool alive.") {
+    cluon::ReceiveBuffer b;
+    REQUIRE(nullptr == b.data());
+    REQUIRE("" == b.toString());
+    {
+        auto pool = std::make_shared<cluon::ReceiveBufferPool>(8, 2);
+        b         = pool->acquire();
+    }
+    REQUIRE(nullptr != b.data());
+    REQUIRE(8 == b.capacity());
+}
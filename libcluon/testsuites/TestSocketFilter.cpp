@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2017-2018  Christian Berger
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "catch.hpp"
+
+#include "cluon/Envelope.hpp"
+#include "cluon/Fragmentation.hpp"
+#include "cluon/OD4Session.hpp"
+#include "cluon/SocketFilter.hpp"
+#include "cluon/UDPReceiver.hpp"
+#include "cluon/UDPSender.hpp"
+#include "cluon/cluonDataStructures.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Create BPF program for dataTypes.") {
+    auto program = cluon::createEnvelopeDataTypeFilter({});
+    // Header checks and final drop.
+    REQUIRE(10 == program.size());
+    REQUIRE(cluon::SocketFilterInstruction::RETURN == program.back().code);
+    REQUIRE(cluon::SocketFilterInstruction::DROP == program.back().k);
+
+    // dataType 1 needs one byte, -100 needs two bytes, 300000 needs three bytes.
+    program = cluon::createEnvelopeDataTypeFilter({1, -100, 300000});
+    REQUIRE(10 + 3 + 5 + 7 == program.size());
+
+    std::vector<int32_t> tooManyDataTypes(1000, 1000000);
+    REQUIRE(cluon::createEnvelopeDataTypeFilter(tooManyDataTypes).empty());
+}
+
+#ifdef __linux__
+TEST_CASE("Attach BPF program for dataTypes to UDPReceiver.") {
+    std::mutex receivedMutex;
+    std::vector<std::string> received;
+
+    cluon::UDPReceiver ur("127.0.0.1", 1244, [&receivedMutex, &received](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        received.emplace_back(d.data(), d.size());
+    }, 0);
+    REQUIRE(ur.isRunning());
+    REQUIRE(ur.setSocketFilter(cluon::createEnvelopeDataTypeFilter({1, -100, 300000})));
+
+    auto serialize = [](int32_t dataType) {
+        cluon::data::Envelope envelope;
+        envelope.dataType(dataType).senderStamp(7);
+        return cluon::serializeEnvelope(std::move(envelope));
+    };
+
+    cluon::UDPSender us("127.0.0.1", 1244);
+    const std::vector<int32_t> DATATYPES{2, 1, 100, -100, 300001, 300000, 0};
+    for (auto dataType : DATATYPES) {
+        us.send(serialize(dataType));
+    }
+    // Fragments and other datagrams pass.
+    auto fragments = cluon::fragment(serialize(3), 1, 100);
+    us.send(std::move(fragments[0]));
+    us.send("Hello World");
+
+    std::vector<std::string> expected{serialize(1), serialize(-100), serialize(300000), cluon::fragment(serialize(3), 1, 100)[0], "Hello World"};
+
+    bool allReceived{false};
+    for (int32_t i{0}; (i < 5000) && !allReceived; i++) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        allReceived = (expected.size() <= received.size());
+    }
+    {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        REQUIRE(expected == received);
+        received.clear();
+    }
+
+    // Detaching the program lets all datagrams pass again.
+    REQUIRE(ur.setSocketFilter({}));
+    us.send(serialize(2));
+    allReceived = false;
+    for (int32_t i{0}; (i < 5000) && !allReceived; i++) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        allReceived = (1 == received.size());
+    }
+    REQUIRE(allReceived);
+}
+
+TEST_CASE("Attach BPF program for dataTypes to UDPReceiver receiving coalesced datagrams.") {
+    std::mutex receivedMutex;
+    std::vector<std::string> received;
+
+    cluon::UDPReceiver ur("127.0.0.1", 1250, [&receivedMutex, &received](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        received.emplace_back(d.data(), d.size());
+    }, 0);
+    REQUIRE(ur.isRunning());
+    const bool HAS_RECEIVE_OFFLOAD{ur.hasReceiveOffload()};
+
+    // The filter must see every datagram; thus, the kernel must not coalesce them anymore.
+    REQUIRE(ur.setSocketFilter(cluon::createEnvelopeDataTypeFilter({1})));
+    REQUIRE(!ur.hasReceiveOffload());
+
+    auto serialize = [](int32_t dataType) {
+        cluon::data::Envelope envelope;
+        envelope.dataType(dataType).senderStamp(7);
+        return cluon::serializeEnvelope(std::move(envelope));
+    };
+
+    // Datagrams of equal size sent at once are candidates for coalescing.
+    std::vector<std::string> datagrams;
+    for (uint32_t i{0}; i < 20; i++) {
+        datagrams.emplace_back(serialize((0 == (i % 2)) ? 1 : 2));
+    }
+    cluon::UDPSender us("127.0.0.1", 1250);
+    REQUIRE(0 == us.send(std::move(datagrams)).second);
+
+    bool allReceived{false};
+    for (int32_t i{0}; (i < 5000) && !allReceived; i++) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        allReceived = (10 <= received.size());
+    }
+    {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(50ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        REQUIRE(std::vector<std::string>(10, serialize(1)) == received);
+    }
+
+    // Detaching the program enables receive offload again.
+    REQUIRE(ur.setSocketFilter({}));
+    REQUIRE(HAS_RECEIVE_OFFLOAD == ur.hasReceiveOffload());
+}
+
+TEST_CASE("Attach BPF programs for shards to UDPReceivers on the same multicast group.") {
+    std::mutex receivedMutex;
+    std::vector<std::vector<int32_t>> received(2);
+
+    auto serialize = [](int32_t dataType) {
+        cluon::data::Envelope envelope;
+        envelope.dataType(dataType);
+        return cluon::serializeEnvelope(std::move(envelope));
+    };
+
+    std::vector<std::unique_ptr<cluon::UDPReceiver>> receivers;
+    for (uint32_t shard{0}; shard < 2; shard++) {
+        receivers.emplace_back(std::make_unique<cluon::UDPReceiver>(
+            "225.0.0.95",
+            1245,
+            [&receivedMutex, &received, shard](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+                auto retVal = cluon::extractEnvelope(d.data(), d.size());
+                std::lock_guard<std::mutex> lck(receivedMutex);
+                received[shard].push_back(retVal.second.dataType());
+            },
+            0));
+        REQUIRE(receivers.back()->isRunning());
+        REQUIRE(receivers.back()->setSocketFilter(cluon::createEnvelopeShardFilter(shard, 2, {}, false)));
+    }
+
+    cluon::UDPSender us("225.0.0.95", 1245);
+    for (int32_t dataType{1}; dataType <= 20; dataType++) {
+        us.send(serialize(dataType));
+    }
+
+    std::size_t total{0};
+    for (int32_t i{0}; (i < 5000) && (20 > total); i++) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        total = received[0].size() + received[1].size();
+    }
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    // Every Envelope is received by exactly one shard and consecutive dataTypes alternate.
+    REQUIRE(10 == received[0].size());
+    REQUIRE(10 == received[1].size());
+    for (std::size_t i{1}; i < received[0].size(); i++) {
+        REQUIRE(received[0][i - 1] + 2 == received[0][i]);
+        REQUIRE(received[1][i - 1] + 2 == received[1][i]);
+    }
+
+    REQUIRE(cluon::createEnvelopeShardFilter(2, 2, {}, false).empty());
+}
+
+TEST_CASE("Create OD4 session with kernel-side dataType filter.") {
+    std::atomic<uint32_t> timeStampsReceived{0};
+    std::atomic<uint32_t> playerCommandsReceived{0};
+
+    cluon::OD4Session od4(93);
+    REQUIRE(od4.dataTrigger(cluon::data::TimeStamp::ID(), [&timeStampsReceived](cluon::data::Envelope &&) { timeStampsReceived++; }));
+    REQUIRE(od4.kernelDataTypeFilter(true));
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (!od4.isRunning());
+
+    cluon::OD4Session od4ToSendFrom(93);
+    do { std::this_thread::sleep_for(1ms); } while (!od4ToSendFrom.isRunning());
+
+    cluon::data::TimeStamp ts;
+    cluon::data::PlayerCommand pc;
+    od4ToSendFrom.send(pc);
+    od4ToSendFrom.send(ts);
+    for (int32_t i{0}; (i < 5000) && (0 == timeStampsReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(1 == timeStampsReceived.load());
+
+    // Adding a dataTrigger regenerates the filter.
+    REQUIRE(od4.dataTrigger(cluon::data::PlayerCommand::ID(), [&playerCommandsReceived](cluon::data::Envelope &&) { playerCommandsReceived++; }));
+    od4ToSendFrom.send(pc);
+    for (int32_t i{0}; (i < 5000) && (0 == playerCommandsReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(1 == playerCommandsReceived.load());
+
+    cluon::OD4Session od4CatchAll(93, [](cluon::data::Envelope &&) {});
+    REQUIRE(!od4CatchAll.kernelDataTypeFilter(true));
+}
+#endif
@@ -11,14 +11,17 @@
 #include "cluon/UDPReceiver.hpp"
 #include "cluon/UDPSender.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 TEST_CASE("Creating UDPReceiver and stop immediately.") {
     cluon::UDPReceiver ur1{"127.0.0.1", 1234, nullptr};
@@ -97,6 +100,277 @@ TEST_CASE("Creating UDPReceiver and receive data.") {
     }
 }
 
+TEST_CASE("Creating UDPReceiver and receive data into pooled buffers.") {
+    // Setup data structures to receive data from UDPReceiver.
+    std::atomic<uint32_t> datagramsReceived{0};
+    std::string data;
+    uint64_t sender{0};
+
+    cluon::UDPReceiver ur7(
+        "127.0.0.1",
+        1241,
+        [&datagramsReceived, &data, &sender](cluon::ReceiveBuffer &&d, uint64_t s, std::chrono::system_clock::time_point &&) noexcept {
+            data   = std::string(d.data(), d.size());
+            sender = s;
+            datagramsReceived++;
+        },
+        0);
+    REQUIRE(ur7.isRunning());
+
+    cluon::UDPSender us7{"127.0.0.1", 1241};
+    for (uint32_t i{1}; i <= 10; i++) {
+        auto retVal = us7.send("Hello World " + std::to_string(i));
+        REQUIRE(0 == retVal.second);
+
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (datagramsReceived.load() < i);
+        REQUIRE(("Hello World " + std::to_string(i)) == data);
+    }
+
+    const std::string SENDER{cluon::decodeSenderAddress(sender)};
+    REQUIRE("127.0.0.1" == SENDER.substr(0, SENDER.find(':')));
+}
+
+TEST_CASE("Creating UDPReceiver and receive small datagrams into small buffers.") {
+    std::atomic<uint32_t> datagramsReceived{0};
+    std::string data;
+    std::size_t capacity{0};
+
+    cluon::UDPReceiver ur9(
+        "127.0.0.1",
+        1244,
+        [&datagramsReceived, &data, &capacity](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+            data     = std::string(d.data(), d.size());
+            capacity = d.capacity();
+            datagramsReceived++;
+        },
+        0);
+    REQUIRE(ur9.isRunning());
+
+    cluon::UDPSender us9{"127.0.0.1", 1244};
+    const std::string SMALL(100, 's');
+    REQUIRE(0 == us9.send(std::string(SMALL)).second);
+    {
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (datagramsReceived.load() < 1);
+    }
+    REQUIRE(SMALL == data);
+    REQUIRE(2048 == capacity);
+
+    const std::string LARGE(10000, 'l');
+    REQUIRE(0 == us9.send(std::string(LARGE)).second);
+    {
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (datagramsReceived.load() < 2);
+    }
+    REQUIRE(LARGE == data);
+    REQUIRE(10000 < capacity);
+}
+
+TEST_CASE("Creating UDPReceiver with an unbounded queue.") {
+    std::atomic<uint32_t> datagramsReceived{0};
+    cluon::UDPReceiver ur12(
+        "127.0.0.1",
+        1247,
+        [&datagramsReceived](cluon::ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&) noexcept { datagramsReceived++; },
+        0,
+        1,
+        nullptr,
+        0);
+    REQUIRE(ur12.isRunning());
+
+    cluon::UDPSender us12{"127.0.0.1", 1247};
+    for (uint32_t i{0}; i < 10; i++) {
+        REQUIRE(0 == us12.send("Hello").second);
+    }
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    for (int32_t i{0}; (i < 5000) && (10 > datagramsReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(10 == datagramsReceived.load());
+}
+
+TEST_CASE("Creating two UDPReceivers where a stalled delegate must not delay the other receiver.") {
+    std::atomic<bool> stalled{true};
+    std::atomic<uint32_t> stalledDatagramsReceived{0};
+    cluon::UDPReceiver ur13(
+        "127.0.0.1",
+        1248,
+        [&stalled, &stalledDatagramsReceived](cluon::ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+            using namespace std::literals::chrono_literals; // NOLINT
+            while (stalled.load()) { std::this_thread::sleep_for(1ms); }
+            stalledDatagramsReceived++;
+        },
+        0);
+    REQUIRE(ur13.isRunning());
+
+    std::atomic<uint32_t> datagramsReceived{0};
+    cluon::UDPReceiver ur14(
+        "127.0.0.1",
+        1249,
+        [&datagramsReceived](cluon::ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&) noexcept { datagramsReceived++; },
+        0);
+    REQUIRE(ur14.isRunning());
+
+    // Send more datagrams than fit into the stalled receiver's queue.
+    using namespace std::literals::chrono_literals; // NOLINT
+    cluon::UDPSender us13{"127.0.0.1", 1248};
+    for (uint32_t i{0}; i < 1500; i++) {
+        us13.send("Hello");
+        if (0 == (i % 100)) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    std::this_thread::sleep_for(50ms);
+
+    cluon::UDPSender us14{"127.0.0.1", 1249};
+    for (uint32_t i{0}; i < 10; i++) {
+        REQUIRE(0 == us14.send("Hello").second);
+    }
+    for (int32_t i{0}; (i < 1000) && (10 > datagramsReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(10 == datagramsReceived.load());
+    REQUIRE(0 == stalledDatagramsReceived.load());
+
+    // The stalled receiver continues once its delegate returns.
+    stalled.store(false);
+    for (int32_t i{0}; (i < 5000) && (1024 > stalledDatagramsReceived.load()); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    REQUIRE(1024 <= stalledDatagramsReceived.load());
+}
+
+TEST_CASE("Creating UDPReceiver and receive datagrams of equal size sent at once.") {
+    std::mutex receivedMutex;
+    std::vector<std::string> received;
+    std::size_t maxCapacity{0};
+
+    cluon::UDPReceiver ur8(
+        "127.0.0.1",
+        1242,
+        [&receivedMutex, &received, &maxCapacity](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+            std::lock_guard<std::mutex> lck(receivedMutex);
+            received.emplace_back(d.data(), d.size());
+            maxCapacity = std::max(maxCapacity, d.capacity());
+        },
+        0);
+    REQUIRE(ur8.isRunning());
+
+    // Equal-sized datagrams followed by a shorter one can be segmented by the kernel.
+    std::vector<std::string> datagrams;
+    for (uint32_t i{0}; i < 20; i++) {
+        datagrams.emplace_back(1000, static_cast<char>('a' + i));
+    }
+    datagrams.emplace_back(500, 'X');
+    datagrams.emplace_back(1000, 'Y');
+    const std::vector<std::string> EXPECTED{datagrams};
+
+    cluon::UDPSender us8{"127.0.0.1", 1242};
+    auto retVal = us8.send(std::move(datagrams));
+    REQUIRE(0 == retVal.second);
+    REQUIRE(21500 == retVal.first);
+
+    bool allReceived{false};
+    for (uint32_t i{0}; (i < 5000) && !allReceived; i++) {
+        using namespace std::literals::chrono_literals; // NOLINT
+        std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lck(receivedMutex);
+        allReceived = (EXPECTED.size() == received.size());
+    }
+
+    std::lock_guard<std::mutex> lck(receivedMutex);
+    REQUIRE(EXPECTED == received);
+
+    // Segments do not pin a slab of the maximum datagram size each.
+    REQUIRE(2048 == maxCapacity);
+}
+
+TEST_CASE("Creating UDPReceiver that drops datagrams from its own sender.") {
+    std::atomic<uint32_t> datagramsReceived{0};
+    std::string data;
+
+    cluon::UDPSender us9{"127.0.0.1", 1243};
+    cluon::UDPReceiver ur9(
+        "127.0.0.1",
+        1243,
+        [&datagramsReceived, &data](cluon::ReceiveBuffer &&d, uint64_t, std::chrono::system_clock::time_point &&) noexcept {
+            data = std::string(d.data(), d.size());
+            datagramsReceived++;
+        },
+        us9.getSendFromPort());
+    REQUIRE(ur9.isRunning());
+
+    auto retVal = us9.send("Hello from us");
+    REQUIRE(0 == retVal.second);
+
+    cluon::UDPSender us10{"127.0.0.1", 1243};
+    retVal = us10.send("Hello from others");
+    REQUIRE(0 == retVal.second);
+
+    using namespace std::literals::chrono_literals; // NOLINT
+    do { std::this_thread::sleep_for(1ms); } while (datagramsReceived.load() < 1);
+    std::this_thread::sleep_for(100ms);
+    REQUIRE(1 == datagramsReceived.load());
+    REQUIRE("Hello from others" == data);
+}
+
+TEST_CASE("Creating UDPReceiver with different time stamp modes and record the delivery latency.") {
+    std::mutex timestampMutex;
+    std::chrono::system_clock::time_point timestamp;
+    std::atomic<uint32_t> datagramsReceived{0};
+
+    cluon::UDPReceiver ur11(
+        "127.0.0.1",
+        1246,
+        [&timestampMutex, &timestamp, &datagramsReceived](cluon::ReceiveBuffer &&, uint64_t, std::chrono::system_clock::time_point &&ts) noexcept {
+            std::lock_guard<std::mutex> lck(timestampMutex);
+            timestamp = ts;
+            datagramsReceived++;
+        },
+        0);
+    REQUIRE(ur11.isRunning());
+    REQUIRE(0 == ur11.deliveryLatency().statistics().samples);
+    REQUIRE(!ur11.deliveryLatency().isEnabled());
+    ur11.deliveryLatency().setEnabled(true);
+
+    std::vector<cluon::ReceiveTimeStampMode> modes{cluon::ReceiveTimeStampMode::USER_SPACE};
+#ifdef __linux__
+    REQUIRE(cluon::ReceiveTimeStampMode::SOFTWARE == ur11.timeStampMode());
+    modes.push_back(cluon::ReceiveTimeStampMode::SOFTWARE);
+    modes.push_back(cluon::ReceiveTimeStampMode::HARDWARE);
+#endif
+
+    cluon::UDPSender us11{"127.0.0.1", 1246};
+    uint32_t expected{0};
+    for (auto mode : modes) {
+        REQUIRE(ur11.setTimeStampMode(mode));
+        REQUIRE(mode == ur11.timeStampMode());
+
+        const auto BEFORE = std::chrono::system_clock::now();
+        REQUIRE(0 == us11.send("Hello").second);
+        expected++;
+
+        using namespace std::literals::chrono_literals; // NOLINT
+        do { std::this_thread::sleep_for(1ms); } while (datagramsReceived.load() < expected);
+        const auto AFTER = std::chrono::system_clock::now();
+
+        // Without a network card time stamp, the kernel's time stamp is used.
+        std::lock_guard<std::mutex> lck(timestampMutex);
+        REQUIRE(BEFORE <= timestamp);
+        REQUIRE(timestamp <= AFTER);
+    }
+
+    auto stats = ur11.deliveryLatency().statistics();
+    REQUIRE(expected == stats.samples);
+    REQUIRE(0 == stats.negativeSamples);
+    REQUIRE(stats.minLatencyInNanoseconds <= stats.medianLatencyInNanoseconds);
+    REQUIRE(stats.medianLatencyInNanoseconds <= stats.maxLatencyInNanoseconds);
+    ur11.deliveryLatency().reset();
+    REQUIRE(0 == ur11.deliveryLatency().statistics().samples);
+}
+
 TEST_CASE("Testing multicast with 226.x.y.z address.") {
     // Setup data structures to receive data from UDPReceiver.
     std::atomic<bool> hasDataReceived{false};
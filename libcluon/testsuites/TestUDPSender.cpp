@@ -13,6 +13,7 @@
 #include <cerrno>
 #include <string>
 #include <utility>
+#include <vector>
 
 // Defining a test fixture to be reused among the test cases.
 class TestFixture_UDPSender {
@@ -61,6 +62,38 @@ TEST_CASE_METHOD(TestFixture_UDPSender, "Trying to send too big data.") {
     REQUIRE(E2BIG == retVal4.second);
 }
 
+TEST_CASE_METHOD(TestFixture_UDPSender, "Send several datagrams at once.") {
+    std::vector<std::string> TEST_DATA{"Hello", "", "World", std::string(1000, 'A')};
+    auto retVal5 = m_us.send(std::move(TEST_DATA));
+    REQUIRE(5 + 5 + 1000 == retVal5.first);
+    REQUIRE(0 == retVal5.second);
+
+    std::vector<std::string> MANY_DATAGRAMS(150, "Hello World");
+    auto retVal6 = m_us.send(std::move(MANY_DATAGRAMS));
+    REQUIRE(150 * 11 == retVal6.first);
+    REQUIRE(0 == retVal6.second);
+
+    std::vector<std::string> NO_DATAGRAMS;
+    auto retVal7 = m_us.send(std::move(NO_DATAGRAMS));
+    REQUIRE(0 == retVal7.first);
+    REQUIRE(0 == retVal7.second);
+}
+
+TEST_CASE_METHOD(TestFixture_UDPSender, "Trying to send several datagrams with one too big.") {
+    std::vector<std::string> TEST_DATA{"Hello World", std::string(0xFFFF - 1, 'A')};
+    auto retVal8 = m_us.send(std::move(TEST_DATA));
+    REQUIRE(-1 == retVal8.first);
+    REQUIRE(E2BIG == retVal8.second);
+}
+
+TEST_CASE("Trying to send several datagrams with faulty sender.") {
+    cluon::UDPSender us4{"127.0.0.256", 5677};
+    std::vector<std::string> TEST_DATA{"Hello", "World"};
+    auto retVal9 = us4.send(std::move(TEST_DATA));
+    REQUIRE(-1 == retVal9.first);
+    REQUIRE(EBADF == retVal9.second);
+}
+
 TEST_CASE("Trying to send data with empty sendToAddress.") {
     cluon::UDPSender us5{"", 1};
     std::string TEST_DATA{"Hello World"};
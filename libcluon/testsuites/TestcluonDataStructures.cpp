@@ -42,6 +42,9 @@ TEST_CASE("Test cluon::data::PlayerCommand.") {
 
     REQUIRE(0 == pc.command());
     REQUIRE(0.0f == Approx(pc.seekTo()));
+    REQUIRE(0 == pc.seekToTimeStamp().seconds());
+    REQUIRE(0 == pc.seekToTimeStamp().microseconds());
+    REQUIRE(0 == pc.seekBy());
 }
 
 TEST_CASE("Test cluon::data::PlayerStatus.") {
@@ -11,6 +11,7 @@
 
 #include "cluon/cluon.hpp"
 #include "cluon/Envelope.hpp"
+#include "cluon/EnvelopeView.hpp"
 #include "cluon/stringtoolbox.hpp"
 
 #include <cstdint>
@@ -87,8 +88,10 @@ inline int32_t cluon_filter(int32_t argc, char **argv) {
         bool foundData{false};
         uint32_t counter{0};
         bool endInitialized{false};
+        // Buffer holding the current OD4-framed Envelope; kept Envelopes are written as-is without re-encoding.
+        std::string frame;
         do {
-            auto retVal = cluon::extractEnvelope(std::cin);
+            auto retVal = cluon::extractEnvelopeView(std::cin, frame);
             foundData = retVal.first;
             if ( (0 < retVal.second.dataType()) && (retVal.second.dataType() != cluon::data::PlayerStatus::ID()) ) {
                 counter++;
@@ -104,13 +107,11 @@ inline int32_t cluon_filter(int32_t argc, char **argv) {
                         sstr << retVal.second.dataType() << "/" << retVal.second.senderStamp();
                         std::string str = sstr.str();
                         if ( (0 < mapOfEnvelopesToKeep.size()) && mapOfEnvelopesToKeep.count(str)) {
-                            str = cluon::serializeEnvelope(std::move(retVal.second));
-                            std::cout << str;
+                            std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
                             std::cout.flush();
                         }
                         if ( (0 < mapOfEnvelopesToDrop.size()) && !mapOfEnvelopesToDrop.count(str)) {
-                            str = cluon::serializeEnvelope(std::move(retVal.second));
-                            std::cout << str;
+                            std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
                             std::cout.flush();
                         }
                     }
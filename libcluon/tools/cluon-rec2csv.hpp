@@ -104,8 +104,8 @@ inline int32_t cluon_rec2csv(int32_t argc, char **argv) {
                     cluon::data::Envelope env{std::move(next.second)};
                     if (scope.count(env.dataType()) > 0) {
                         cluon::FromProtoVisitor protoDecoder;
-                        std::stringstream sstr(env.serializedData());
-                        protoDecoder.decodeFrom(sstr);
+                        const std::string payloadData{env.serializedData()};
+                        protoDecoder.decodeFrom(payloadData.data(), payloadData.size());
 
                         cluon::MetaMessage m = scope[env.dataType()];
                         cluon::GenericMessage gm;
@@ -14,6 +14,7 @@
 #include "cluon/OD4Session.hpp"
 #include "cluon/ToProtoVisitor.hpp"
 #include "cluon/Player.hpp"
+#include "cluon/Time.hpp"
 #include "cluon/cluonDataStructures.hpp"
 
 #include <cstdint>
@@ -30,7 +31,7 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
     auto commandlineArguments = cluon::getCommandlineArguments(argc, argv);
     if (1 == argc) {
         std::cerr << PROGRAM << " replays a .rec file into an OpenDaVINCI session or to stdout; if playing back to an OD4Session using parameter --cid, you can specify the optional parameter --stdout to also playback to stdout; --keeprunning keeps " << PROGRAM << " open at the end of a recording file." << std::endl;
-        std::cerr << "Usage:   " << PROGRAM << " [--cid=<OpenDaVINCI session> [--stdout] [--keeprunning]] [--nodelay] recording.rec" << std::endl;
+        std::cerr << "Usage:   " << PROGRAM << " [--cid=<OpenDaVINCI session> [--stdout] [--keeprunning]] [--nodelay] [--mmap] recording.rec" << std::endl;
         std::cerr << "Example: " << PROGRAM << " --cid=111 file.rec" << std::endl;
         std::cerr << "         " << PROGRAM << " --cid=111 --stdout file.rec" << std::endl;
         std::cerr << "         " << PROGRAM << " file.rec" << std::endl;
@@ -40,6 +41,7 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
         const bool playBackToStdout = ( (0 != commandlineArguments.count("stdout")) || (0 == commandlineArguments.count("cid")) );
         const bool keepRunning = (0 != commandlineArguments.count("keeprunning"));
         const bool noDelay = (0 != commandlineArguments.count("nodelay"));
+        const bool memoryMapped = (0 != commandlineArguments.count("mmap"));
 
         std::string recFile;
         for (auto e : commandlineArguments) {
@@ -102,7 +104,7 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
             }
             constexpr bool AUTOREWIND{false};
             const bool THREADING{!noDelay};
-            cluon::Player player(recFile, AUTOREWIND, THREADING);
+            cluon::Player player(recFile, AUTOREWIND, THREADING, memoryMapped);
             player.setPlayerListener([&playerStatusUpdate, &playerStatusMutex, &playerStatus](cluon::data::PlayerStatus &&ps){
                 {
                     std::lock_guard<std::mutex> lck(playerStatusMutex);
@@ -188,6 +190,16 @@ inline int32_t cluon_replay(int32_t argc, char **argv) {
                         player.seekTo(playerCommand.seekTo());
                     }
 
+                    if (5 == playerCommand.command()) {
+                        std::cerr << PROGRAM << ": Change state: " << +playerCommand.command() << ", seekToTimeStamp: " << cluon::time::toMicroseconds(playerCommand.seekToTimeStamp()) << std::endl;
+                        player.seekToTimeStamp(playerCommand.seekToTimeStamp());
+                    }
+
+                    if (6 == playerCommand.command()) {
+                        std::cerr << PROGRAM << ": Change state: " << +playerCommand.command() << ", seekBy: " << playerCommand.seekBy() << std::endl;
+                        player.seekBy(playerCommand.seekBy());
+                    }
+
                     if (4 == playerCommand.command()) {
                         play = false;
                         step = true;